@@ -0,0 +1,223 @@
+#ifndef EXEC_BENCHMARKS_BENCHMARK_HPP
+#define EXEC_BENCHMARKS_BENCHMARK_HPP
+
+#include <exec.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <print>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace exec::bench {
+    template<typename T>
+    inline void do_not_optimize(const T& value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        const volatile auto* sink = &reinterpret_cast<const volatile char&>(value);
+        static_cast<void>(*sink);
+#endif
+    }
+
+    // Receiver consuming every completion without doing any work, the measured time is the sender's alone.
+    struct sink_receiver {
+        using receiver_concept = receiver_t;
+
+        template<typename... Ts>
+        void set_value(Ts&&... values) && noexcept {
+            (do_not_optimize(values), ...);
+        }
+
+        template<typename T>
+        void set_error(T&& error) && noexcept {
+            do_not_optimize(error);
+        }
+
+        void set_stopped() && noexcept {
+
+        }
+    };
+
+    struct benchmark {
+        std::string_view name;
+        void (*run)(std::uint64_t iterations);
+    };
+
+    struct result {
+        std::string_view name;
+        std::uint64_t iterations;
+        double ns_per_op;
+        double min_ns_per_op;
+    };
+
+    struct percentiles {
+        std::int64_t p50;
+        std::int64_t p99;
+        std::int64_t p999;
+    };
+
+    // Nearest rank percentiles of a set of latency samples, which are sorted in place.
+    [[nodiscard]] inline percentiles compute_percentiles(std::span<std::int64_t> samples) {
+        if (samples.empty()) {
+            return {};
+        }
+
+        std::ranges::sort(samples);
+
+        const auto rank = [&samples](double fraction) noexcept {
+            const auto index = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(samples.size())));
+            return samples[std::clamp<std::size_t>(index, 1, samples.size()) - 1];
+        };
+
+        return { rank(0.5), rank(0.99), rank(0.999) };
+    }
+
+    struct options {
+        bool json{ false };
+        std::string_view filter{};
+        std::chrono::milliseconds min_time{ 100 };
+        std::uint32_t repetitions{ 5 };
+    };
+
+    namespace details {
+        template<typename T>
+        [[nodiscard]] std::optional<T> parse_number(std::string_view text) noexcept {
+            T value{};
+            const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (error != std::errc{} || end != text.data() + text.size()) {
+                return std::nullopt;
+            }
+
+            return value;
+        }
+
+        [[nodiscard]] inline std::optional<options> parse_options(std::span<char*> args) {
+            options opts{};
+
+            for (std::string_view arg : args.subspan(1)) {
+                if (arg == "--json") {
+                    opts.json = true;
+                }
+                else if (arg.starts_with("--filter=")) {
+                    opts.filter = arg.substr(9);
+                }
+                else if (arg.starts_with("--min-time-ms=")) {
+                    const auto value = parse_number<std::uint32_t>(arg.substr(14));
+                    if (!value.has_value()) {
+                        return std::nullopt;
+                    }
+
+                    opts.min_time = std::chrono::milliseconds(*value);
+                }
+                else if (arg.starts_with("--repetitions=")) {
+                    const auto value = parse_number<std::uint32_t>(arg.substr(14));
+                    if (!value.has_value() || *value == 0) {
+                        return std::nullopt;
+                    }
+
+                    opts.repetitions = *value;
+                }
+                else {
+                    return std::nullopt;
+                }
+            }
+
+            return opts;
+        }
+
+        [[nodiscard]] inline std::chrono::nanoseconds time(const benchmark& bench, std::uint64_t iterations) {
+            const auto begin = std::chrono::steady_clock::now();
+            bench.run(iterations);
+            return std::chrono::steady_clock::now() - begin;
+        }
+
+        // Grows the iteration count until one batch runs for at least the minimum time, then reports the median and
+        // the fastest of the timed repetitions of that batch.
+        [[nodiscard]] inline result measure(const benchmark& bench, const options& opts) {
+            std::uint64_t iterations = 1;
+            for (;;) {
+                const auto elapsed = time(bench, iterations);
+                if (elapsed >= opts.min_time || iterations >= (std::uint64_t{ 1 } << 40)) {
+                    break;
+                }
+
+                const auto scale = elapsed.count() > 0 ? (opts.min_time * 1.2) / elapsed : 100.0;
+                iterations = std::max(iterations + 1,
+                                      static_cast<std::uint64_t>(static_cast<double>(iterations) *
+                                                                 std::min(scale, 100.0)));
+            }
+
+            std::vector<double> samples(opts.repetitions);
+            for (auto& sample : samples) {
+                sample = static_cast<double>(time(bench, iterations).count()) / static_cast<double>(iterations);
+            }
+
+            std::ranges::sort(samples);
+
+            return { bench.name, iterations, samples[samples.size() / 2], samples.front() };
+        }
+
+        inline void print_text(std::span<const result> results) {
+            std::println("{:<32} {:>14} {:>12} {:>12}", "benchmark", "iterations", "ns/op", "min ns/op");
+            for (const auto& res : results) {
+                std::println("{:<32} {:>14} {:>12.2f} {:>12.2f}",
+                             res.name,
+                             res.iterations,
+                             res.ns_per_op,
+                             res.min_ns_per_op);
+            }
+        }
+
+        inline void print_json(std::span<const result> results) {
+            std::println("{{");
+            std::println("  \"benchmarks\": [");
+            for (std::size_t i = 0; i < results.size(); ++i) {
+                const auto& res = results[i];
+                std::println("    {{ \"name\": \"{}\", \"iterations\": {}, \"ns_per_op\": {:.3f}, "
+                             "\"min_ns_per_op\": {:.3f} }}{}",
+                             res.name,
+                             res.iterations,
+                             res.ns_per_op,
+                             res.min_ns_per_op,
+                             i + 1 < results.size() ? "," : "");
+            }
+            std::println("  ]");
+            std::println("}}");
+        }
+    }
+
+    // Runs every benchmark whose name contains the --filter text and prints a table, or a JSON document with
+    // --json. --min-time-ms and --repetitions tune the measurement.
+    inline int run(std::span<const benchmark> benchmarks, int argc, char** argv) {
+        const auto opts = details::parse_options({ argv, static_cast<std::size_t>(argc) });
+        if (!opts.has_value()) {
+            std::println(stderr, "usage: {} [--json] [--filter=TEXT] [--min-time-ms=N] [--repetitions=N]", argv[0]);
+            return 1;
+        }
+
+        std::vector<result> results;
+        for (const auto& bench : benchmarks) {
+            if (bench.name.find(opts->filter) != std::string_view::npos) {
+                results.push_back(details::measure(bench, *opts));
+            }
+        }
+
+        if (opts->json) {
+            details::print_json(results);
+        }
+        else {
+            details::print_text(results);
+        }
+
+        return 0;
+    }
+}
+
+#endif // !EXEC_BENCHMARKS_BENCHMARK_HPP
\ No newline at end of file
@@ -0,0 +1,371 @@
+#include <benchmark.hpp>
+
+#include <exec.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <latch>
+#include <memory>
+#include <optional>
+#include <print>
+#include <span>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+    using steady_clock = std::chrono::steady_clock;
+
+    [[nodiscard]] std::int64_t elapsed_ns(steady_clock::time_point since) noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - since).count();
+    }
+
+    // The pool of examples/counting_scopes, every thread runs the same run_loop.
+    class run_loop_pool {
+    public:
+        explicit run_loop_pool(std::uint32_t thread_count, exec::run_loop_policy policy = {}) : m_loop(policy) {
+            m_threads.reserve(thread_count);
+
+            for (std::uint32_t i = 0; i < thread_count; ++i) {
+                m_threads.emplace_back([this](std::stop_token st) {
+                    std::stop_callback sc(st, [this] { m_loop.finish(); });
+                    m_loop.run();
+                });
+            }
+        }
+
+        ~run_loop_pool() noexcept {
+            for (auto& thread : m_threads) {
+                thread.request_stop();
+            }
+        }
+
+        exec::scheduler auto get_scheduler() noexcept {
+            return m_loop.get_scheduler();
+        }
+
+    private:
+        exec::run_loop m_loop;
+        std::vector<std::jthread> m_threads;
+
+    };
+
+    struct run_loop_variant {
+        static constexpr std::string_view name = "run_loop";
+
+        [[nodiscard]] static auto make(std::uint32_t thread_count) {
+            return std::make_unique<run_loop_pool>(thread_count);
+        }
+    };
+
+    struct batch_run_loop_variant {
+        static constexpr std::string_view name = "run_loop(batch)";
+
+        [[nodiscard]] static auto make(std::uint32_t thread_count) {
+            return std::make_unique<run_loop_pool>(
+                thread_count,
+                exec::run_loop_policy{ .drain = exec::run_loop_policy::drain_mode::batch, .max_spin = 4096 });
+        }
+    };
+
+    struct static_thread_pool_variant {
+        static constexpr std::string_view name = "static_thread_pool";
+
+        [[nodiscard]] static auto make(std::uint32_t thread_count) {
+            return std::make_unique<exec::static_thread_pool>(thread_count);
+        }
+    };
+
+    template<typename VariantT>
+    using scheduler_of_t = decltype(VariantT::make(1)->get_scheduler());
+
+    struct measurement {
+        std::uint64_t ops;
+        std::chrono::nanoseconds elapsed;
+        std::vector<std::int64_t> latencies;
+    };
+
+    struct timed_slot {
+        steady_clock::time_point scheduled;
+        std::int64_t latency;
+    };
+
+    [[nodiscard]] std::vector<std::int64_t> latencies_of(std::span<const timed_slot> slots) {
+        std::vector<std::int64_t> latencies;
+        latencies.reserve(slots.size());
+
+        for (const auto& slot : slots) {
+            latencies.push_back(slot.latency);
+        }
+
+        return latencies;
+    }
+
+    template<exec::scheduler SchedulerT>
+    exec::task<> ping_pong_player(SchedulerT ping,
+                                  SchedulerT pong,
+                                  std::uint64_t round_trips,
+                                  std::int64_t* latencies)
+    {
+        co_await (exec::just() | exec::continues_on(ping));
+
+        for (std::uint64_t i = 0; i < round_trips; ++i) {
+            auto sent = steady_clock::now();
+            co_await (exec::just() | exec::continues_on(pong));
+            *latencies++ = elapsed_ns(sent);
+
+            sent = steady_clock::now();
+            co_await (exec::just() | exec::continues_on(ping));
+            *latencies++ = elapsed_ns(sent);
+        }
+    }
+
+    // `threads` players bounce between two pools of `threads` threads each, one sample per hop.
+    template<typename VariantT>
+    measurement ping_pong(std::uint32_t threads, std::uint64_t ops) {
+        const std::uint64_t round_trips = std::max<std::uint64_t>(ops / (2 * threads), 1);
+
+        auto ping = VariantT::make(threads);
+        auto pong = VariantT::make(threads);
+
+        std::vector<std::int64_t> latencies(round_trips * 2 * threads);
+        std::latch ready(threads + 1);
+
+        std::vector<std::jthread> players;
+        players.reserve(threads);
+
+        for (std::uint32_t i = 0; i < threads; ++i) {
+            players.emplace_back([&, i] {
+                ready.arrive_and_wait();
+                exec::sync_wait(ping_pong_player(ping->get_scheduler(),
+                                                 pong->get_scheduler(),
+                                                 round_trips,
+                                                 latencies.data() + i * round_trips * 2));
+            });
+        }
+
+        ready.arrive_and_wait();
+        const auto begin = steady_clock::now();
+        players.clear();
+
+        return { latencies.size(), steady_clock::now() - begin, std::move(latencies) };
+    }
+
+    struct timed_receiver {
+        using receiver_concept = exec::receiver_t;
+
+        timed_slot* slot;
+        std::latch* done;
+
+        void set_value() && noexcept {
+            slot->latency = elapsed_ns(slot->scheduled);
+            done->count_down();
+        }
+
+        void set_error(auto&&) && noexcept {
+            done->count_down();
+        }
+
+        void set_stopped() && noexcept {
+            done->count_down();
+        }
+    };
+
+    // `threads` producers schedule onto a pool of `threads` threads, measuring from start() to the completion.
+    template<typename VariantT>
+    measurement fan_out(std::uint32_t threads, std::uint64_t ops) {
+        using operation_t =
+            exec::connect_result_t<exec::details::schedule_result_t<scheduler_of_t<VariantT>>, timed_receiver>;
+
+        const std::uint64_t per_producer = std::max<std::uint64_t>(ops / threads, 1);
+        const std::uint64_t total = per_producer * threads;
+
+        // The pool is declared after the latch, so its threads are joined before the latch goes away.
+        std::vector<timed_slot> slots(total);
+        std::latch done(static_cast<std::ptrdiff_t>(total));
+
+        auto pool = VariantT::make(threads);
+
+        auto operations = std::make_unique<std::optional<operation_t>[]>(total);
+        for (std::uint64_t i = 0; i < total; ++i) {
+            operations[i].emplace(exec::details::emplace_from{ [&] {
+                return exec::connect(exec::schedule(pool->get_scheduler()), timed_receiver{ &slots[i], &done });
+            } });
+        }
+
+        std::latch ready(threads + 1);
+
+        std::vector<std::jthread> producers;
+        producers.reserve(threads);
+
+        for (std::uint32_t p = 0; p < threads; ++p) {
+            producers.emplace_back([&, p] {
+                ready.arrive_and_wait();
+
+                for (std::uint64_t i = p * per_producer; i < (p + 1) * per_producer; ++i) {
+                    slots[i].scheduled = steady_clock::now();
+                    exec::start(*operations[i]);
+                }
+            });
+        }
+
+        ready.arrive_and_wait();
+        const auto begin = steady_clock::now();
+        done.wait();
+        const auto elapsed = steady_clock::now() - begin;
+
+        producers.clear();
+
+        return { total, elapsed, latencies_of(slots) };
+    }
+
+    // examples/counting_scopes without the timers: `threads` producers spawn onto a pool of `threads` threads, the
+    // elapsed time runs until the scope is joined.
+    template<typename ScopeT, typename VariantT>
+    measurement spawn_join(std::uint32_t threads, std::uint64_t ops) {
+        const std::uint64_t per_producer = std::max<std::uint64_t>(ops / threads, 1);
+        const std::uint64_t total = per_producer * threads;
+
+        std::vector<timed_slot> slots(total);
+
+        auto pool = VariantT::make(threads);
+        ScopeT scope;
+
+        std::latch ready(threads + 1);
+
+        std::vector<std::jthread> producers;
+        producers.reserve(threads);
+
+        for (std::uint32_t p = 0; p < threads; ++p) {
+            producers.emplace_back([&, p] {
+                ready.arrive_and_wait();
+
+                for (std::uint64_t i = p * per_producer; i < (p + 1) * per_producer; ++i) {
+                    timed_slot* const slot = &slots[i];
+
+                    slot->scheduled = steady_clock::now();
+                    exec::spawn(exec::schedule(pool->get_scheduler()) |
+                                exec::then([slot]() noexcept { slot->latency = elapsed_ns(slot->scheduled); }) |
+                                exec::upon_error([](auto&&) noexcept {}),
+                                scope.get_token());
+                }
+            });
+        }
+
+        ready.arrive_and_wait();
+        const auto begin = steady_clock::now();
+        producers.clear();
+
+        scope.close();
+        exec::sync_wait(scope.join());
+        const auto elapsed = steady_clock::now() - begin;
+
+        return { total, elapsed, latencies_of(slots) };
+    }
+
+    struct workload {
+        std::string_view name;
+        std::string_view scheduler;
+        measurement (*run)(std::uint32_t threads, std::uint64_t ops);
+    };
+
+    template<typename... VariantTs>
+    constexpr auto make_workloads() {
+        return std::array{
+            workload{ "ping_pong", VariantTs::name, &ping_pong<VariantTs> }...,
+            workload{ "fan_out", VariantTs::name, &fan_out<VariantTs> }...,
+            workload{ "spawn_join(counting_scope)",
+                      VariantTs::name,
+                      &spawn_join<exec::counting_scope, VariantTs> }...,
+            workload{ "spawn_join(sharded_counting_scope)",
+                      VariantTs::name,
+                      &spawn_join<exec::sharded_counting_scope, VariantTs> }...,
+        };
+    }
+
+    constexpr auto workloads = make_workloads<run_loop_variant, batch_run_loop_variant, static_thread_pool_variant>();
+
+    struct options {
+        std::uint32_t max_threads{ std::max(std::thread::hardware_concurrency(), 1u) };
+        std::uint64_t ops{ 200'000 };
+        std::string_view filter{};
+    };
+
+    [[nodiscard]] std::optional<options> parse_options(std::span<char*> args) {
+        options opts{};
+
+        for (std::string_view arg : args.subspan(1)) {
+            if (arg.starts_with("--filter=")) {
+                opts.filter = arg.substr(9);
+            }
+            else if (arg.starts_with("--max-threads=")) {
+                const auto value = exec::bench::details::parse_number<std::uint32_t>(arg.substr(14));
+                if (!value.has_value() || *value == 0) {
+                    return std::nullopt;
+                }
+
+                opts.max_threads = *value;
+            }
+            else if (arg.starts_with("--ops=")) {
+                const auto value = exec::bench::details::parse_number<std::uint64_t>(arg.substr(6));
+                if (!value.has_value() || *value == 0) {
+                    return std::nullopt;
+                }
+
+                opts.ops = *value;
+            }
+            else {
+                return std::nullopt;
+            }
+        }
+
+        return opts;
+    }
+}
+
+// Prints one CSV row per workload, scheduler and thread count, thread counts double from 1 up to --max-threads.
+int main(int argc, char** argv) {
+    const auto opts = parse_options({ argv, static_cast<std::size_t>(argc) });
+    if (!opts.has_value()) {
+        std::println(stderr, "usage: {} [--filter=TEXT] [--max-threads=N] [--ops=N]", argv[0]);
+        return 1;
+    }
+
+    std::println("workload,scheduler,threads,ops,seconds,ops_per_sec,p50_ns,p99_ns,p999_ns");
+
+    for (const auto& load : workloads) {
+        if (load.name.find(opts->filter) == std::string_view::npos &&
+            load.scheduler.find(opts->filter) == std::string_view::npos)
+        {
+            continue;
+        }
+
+        for (std::uint32_t threads = 1;; threads = std::min(threads * 2, opts->max_threads)) {
+            auto result = load.run(threads, opts->ops);
+
+            const auto [p50, p99, p999] = exec::bench::compute_percentiles(result.latencies);
+            const double seconds = std::chrono::duration<double>(result.elapsed).count();
+
+            std::println("{},{},{},{},{:.6f},{:.0f},{},{},{}",
+                         load.name,
+                         load.scheduler,
+                         threads,
+                         result.ops,
+                         seconds,
+                         static_cast<double>(result.ops) / seconds,
+                         p50,
+                         p99,
+                         p999);
+
+            if (threads == opts->max_threads) {
+                break;
+            }
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include <benchmark.hpp>
+
+#include <exec.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace {
+    // Connects and starts `make_sender(i)` once per iteration, the completion reaches a receiver doing nothing.
+    template<auto MakeSender>
+    void connect_start(std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            auto op = exec::connect(MakeSender(static_cast<int>(i)), exec::bench::sink_receiver{});
+            exec::start(op);
+        }
+    }
+
+    struct loop_receiver {
+        using receiver_concept = exec::receiver_t;
+
+        exec::run_loop* loop;
+
+        void set_value(auto&&... values) && noexcept {
+            (exec::bench::do_not_optimize(values), ...);
+            loop->finish();
+        }
+
+        void set_error(auto&&) && noexcept {
+            loop->finish();
+        }
+
+        void set_stopped() && noexcept {
+            loop->finish();
+        }
+    };
+
+    // Every iteration goes through a fresh run_loop, the same hop a sync_wait caller pays for.
+    template<auto Adaptor>
+    void hop(std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            exec::run_loop loop;
+
+            auto op = exec::connect(Adaptor(loop.get_scheduler(), static_cast<int>(i)), loop_receiver{ &loop });
+            exec::start(op);
+
+            loop.run();
+        }
+    }
+
+    void sync_wait(std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            auto result = exec::sync_wait(exec::just(static_cast<int>(i)));
+            exec::bench::do_not_optimize(result);
+        }
+    }
+
+    void sync_wait_then(std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            auto result = exec::sync_wait(exec::just(static_cast<int>(i)) | exec::then([](int value) {
+                return value + 1;
+            }));
+            exec::bench::do_not_optimize(result);
+        }
+    }
+
+    constexpr std::array benchmarks{
+        exec::bench::benchmark{ "just", &connect_start<[](int value) {
+            return exec::just(value);
+        }> },
+        exec::bench::benchmark{ "just | then", &connect_start<[](int value) {
+            return exec::just(value) | exec::then([](int x) { return x + 1; });
+        }> },
+        exec::bench::benchmark{ "just | then x4", &connect_start<[](int value) {
+            return exec::just(value) |
+                   exec::then([](int x) { return x + 1; }) |
+                   exec::then([](int x) { return x * 2; }) |
+                   exec::then([](int x) { return x - 1; }) |
+                   exec::then([](int x) { return x / 2; });
+        }> },
+        exec::bench::benchmark{ "just | let_value", &connect_start<[](int value) {
+            return exec::just(value) | exec::let_value([](int x) { return exec::just(x + 1); });
+        }> },
+        exec::bench::benchmark{ "just_error | upon_error", &connect_start<[](int value) {
+            return exec::just_error(value) | exec::upon_error([](int x) { return x + 1; });
+        }> },
+        exec::bench::benchmark{ "schedule_from(run_loop)", &hop<[](auto scheduler, int value) {
+            return exec::schedule_from(scheduler, exec::just(value));
+        }> },
+        exec::bench::benchmark{ "just | continues_on(run_loop)", &hop<[](auto scheduler, int value) {
+            return exec::just(value) | exec::continues_on(scheduler);
+        }> },
+        exec::bench::benchmark{ "sync_wait(just)", &sync_wait },
+        exec::bench::benchmark{ "sync_wait(just | then)", &sync_wait_then },
+    };
+}
+
+int main(int argc, char** argv) {
+    return exec::bench::run(benchmarks, argc, argv);
+}
\ No newline at end of file
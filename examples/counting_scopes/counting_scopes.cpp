@@ -41,6 +41,9 @@ int main() {
 
     simple_thread_pool pool{ std::thread::hardware_concurrency() };
 
+    exec::timed_run_loop timers;
+    std::thread timer_thread([&timers] { timers.run(); });
+
     auto closure = exec::let_value([](int id, uint32_t seed) {
                         thread_local std::mt19937 gen{ seed };
                         thread_local std::uniform_int_distribution dist{ 500, 1500 };
@@ -52,9 +55,10 @@ int main() {
                         return exec::just(id, value);
                    }) |
                    exec::continues_on(pool.get_scheduler()) |
-                   exec::then([](int id, uint32_t value) {
+                   exec::let_value([&timers](int id, uint32_t value) {
                        std::println("[{}] Sleep {}ms from {}", id, value, std::this_thread::get_id());
-                       std::this_thread::sleep_for(std::chrono::milliseconds(value));
+
+                       return exec::schedule_after(timers.get_scheduler(), std::chrono::milliseconds(value));
                    }) |
                    exec::let_error([](auto&&) noexcept {
                        return exec::just();
@@ -73,5 +77,8 @@ int main() {
 
     std::println("All tasks finished");
 
+    timers.finish();
+    timer_thread.join();
+
     return 0;
 }
\ No newline at end of file
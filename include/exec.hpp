@@ -3,19 +3,28 @@
 
 #include "exec/allocator.hpp"
 #include "exec/associate.hpp"
+#include "exec/async_generator.hpp"
+#include "exec/bulk.hpp"
 #include "exec/completion_signatures.hpp"
 #include "exec/completions.hpp"
 #include "exec/continues_on.hpp"
 #include "exec/counting_scopes.hpp"
+#include "exec/ensure_started.hpp"
 #include "exec/env.hpp"
+#include "exec/epoll_context.hpp"
 #include "exec/forward_progress_guarantee.hpp"
 #include "exec/forwarding_query.hpp"
+#include "exec/io.hpp"
+#include "exec/io_uring_context.hpp"
 #include "exec/just.hpp"
 #include "exec/let.hpp"
+#include "exec/monotonic_arena.hpp"
 #include "exec/operation_state.hpp"
+#include "exec/pool_allocator.hpp"
 #include "exec/queryable.hpp"
 #include "exec/receiver.hpp"
 #include "exec/run_loop.hpp"
+#include "exec/run_loop_metrics.hpp"
 #include "exec/schedule_from.hpp"
 #include "exec/scheduler.hpp"
 #include "exec/scope_association.hpp"
@@ -23,10 +32,21 @@
 #include "exec/sender.hpp"
 #include "exec/sender_adapter_closure.hpp"
 #include "exec/spawn.hpp"
+#include "exec/split.hpp"
 #include "exec/starts_on.hpp"
+#include "exec/static_thread_pool.hpp"
 #include "exec/stop_token.hpp"
 #include "exec/sync_wait.hpp"
+#include "exec/task.hpp"
 #include "exec/then.hpp"
+#include "exec/timed_run_loop.hpp"
+#include "exec/timed_scheduler.hpp"
+#include "exec/trace_recorder.hpp"
+#include "exec/tracer.hpp"
 #include "exec/transform_completion_signatures.hpp"
+#include "exec/when_all.hpp"
+#include "exec/when_any.hpp"
+#include "exec/with_allocator.hpp"
+#include "exec/with_tracer.hpp"
 
 #endif // !EXEC_EXEC_HPP
\ No newline at end of file
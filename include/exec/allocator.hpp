@@ -19,7 +19,7 @@ namespace exec {
 
     struct get_allocator_t {
         template<typename EnvT>
-        [[nodiscard]] constexpr allocator decltype(auto) operator()(const EnvT& env) const noexcept {
+        [[nodiscard]] constexpr allocator auto operator()(const EnvT& env) const noexcept {
             return env.query(*this);
         }
 
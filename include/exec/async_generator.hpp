@@ -0,0 +1,212 @@
+#ifndef EXEC_ASYNC_GENERATOR_HPP
+#define EXEC_ASYNC_GENERATOR_HPP
+
+#include "exec/completions.hpp"
+#include "exec/completion_signatures.hpp"
+#include "exec/env.hpp"
+#include "exec/operation_state.hpp"
+#include "exec/receiver.hpp"
+#include "exec/sender.hpp"
+#include "exec/stop_token.hpp"
+#include "exec/task.hpp"
+
+#include "exec/details/sender_awaitable.hpp"
+#include "exec/details/stop_token_bridge.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace exec {
+    // A coroutine producing a stream of T. Senders and tasks can be awaited inside it, each `co_yield` suspends it
+    // until the consumer asks for the next item. Consumers pull with `next()`, a sender completing with a pointer to
+    // the yielded object, valid until the following `next()` is started, or with nullptr once the stream ended.
+    template<typename T>
+    class async_generator {
+    public:
+        class promise_type;
+
+        using pointer = std::add_pointer_t<T>;
+
+        struct env {
+            const promise_type* promise;
+
+            [[nodiscard]] inplace_stop_token query(get_stop_token_t) const noexcept {
+                return promise->m_token;
+            }
+        };
+
+        class promise_type : public details::task_promise_base {
+        public:
+            struct yield_awaiter {
+                [[nodiscard]] static constexpr bool await_ready() noexcept {
+                    return false;
+                }
+
+                [[nodiscard]] std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                    promise_type& promise = handle.promise();
+
+                    promise.m_on_complete(promise.m_op);
+                    return std::noop_coroutine();
+                }
+
+                static constexpr void await_resume() noexcept {}
+            };
+
+            [[nodiscard]] async_generator get_return_object() noexcept {
+                return async_generator{ std::coroutine_handle<promise_type>::from_promise(*this) };
+            }
+
+            [[nodiscard]] yield_awaiter yield_value(std::remove_reference_t<T>& value) noexcept {
+                m_value = std::addressof(value);
+                return {};
+            }
+
+            [[nodiscard]] yield_awaiter yield_value(std::remove_reference_t<T>&& value) noexcept {
+                m_value = std::addressof(value);
+                return {};
+            }
+
+            static constexpr void return_void() noexcept {}
+
+            template<typename AwaitableT>
+            [[nodiscard]] decltype(auto) await_transform(AwaitableT&& awaitable) {
+                if constexpr (details::is_task_v<std::remove_cvref_t<AwaitableT>>) {
+                    return std::forward<AwaitableT>(awaitable);
+                }
+                else if constexpr (sender<AwaitableT>) {
+                    return details::sender_awaitable<AwaitableT, promise_type>{
+                        std::forward<AwaitableT>(awaitable), *this };
+                }
+                else {
+                    return std::forward<AwaitableT>(awaitable);
+                }
+            }
+
+            [[nodiscard]] constexpr env get_env() const noexcept {
+                return { this };
+            }
+
+        private:
+            friend class async_generator;
+
+            pointer m_value{ nullptr };
+            bool m_stopped{ false };
+
+        };
+
+        class next_sender {
+        public:
+            using sender_concept = exec::sender_t;
+
+            using completion_signatures =
+                exec::completion_signatures<exec::set_value_t(pointer),
+                                            exec::set_error_t(std::exception_ptr),
+                                            exec::set_stopped_t()>;
+
+            template<receiver ReceiverT>
+            [[nodiscard]] auto connect(ReceiverT receiver) const noexcept(std::is_nothrow_move_constructible_v<ReceiverT>) {
+                return operation<ReceiverT>{ m_handle, std::move(receiver) };
+            }
+
+        private:
+            friend class async_generator;
+
+            explicit next_sender(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) {}
+
+            std::coroutine_handle<promise_type> m_handle;
+
+        };
+
+        async_generator(async_generator&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+
+        async_generator& operator=(async_generator&& other) noexcept {
+            if (this != std::addressof(other)) {
+                if (m_handle) {
+                    m_handle.destroy();
+                }
+                m_handle = std::exchange(other.m_handle, {});
+            }
+            return *this;
+        }
+
+        ~async_generator() {
+            if (m_handle) {
+                m_handle.destroy();
+            }
+        }
+
+        // Resumes the generator up to its next `co_yield`. At most one `next()` may be outstanding at a time.
+        [[nodiscard]] next_sender next() const noexcept {
+            return next_sender{ m_handle };
+        }
+
+    private:
+        template<typename ReceiverT>
+        class operation {
+        public:
+            using operation_state_concept = exec::operation_state_t;
+
+            explicit operation(std::coroutine_handle<promise_type> handle, ReceiverT&& receiver)
+                noexcept(std::is_nothrow_move_constructible_v<ReceiverT>) :
+                    m_handle(handle),
+                    m_receiver(std::move(receiver)) {}
+
+            operation(operation&&) = delete;
+
+            void start() & noexcept {
+                // A stopped generator stays suspended where it was cancelled and is never resumed again.
+                if (m_handle.done() || m_handle.promise().m_stopped) {
+                    exec::set_value(std::move(m_receiver), pointer{ nullptr });
+                    return;
+                }
+
+                promise_type& promise = m_handle.promise();
+
+                promise.m_op = this;
+                promise.m_on_complete = &operation::yielded;
+                promise.m_on_stopped = &operation::stopped;
+                promise.m_value = nullptr;
+                promise.m_token = m_stop_bridge.attach(get_stop_token(exec::get_env(m_receiver)));
+
+                m_handle.resume();
+            }
+
+        private:
+            static void yielded(void* op) noexcept {
+                auto* const self = static_cast<operation*>(op);
+                promise_type& promise = self->m_handle.promise();
+                self->m_stop_bridge.detach();
+
+                if (promise.m_exception) {
+                    exec::set_error(std::move(self->m_receiver), std::exchange(promise.m_exception, {}));
+                }
+                else {
+                    exec::set_value(std::move(self->m_receiver), promise.m_value);
+                }
+            }
+
+            static void stopped(void* op) noexcept {
+                auto* const self = static_cast<operation*>(op);
+                self->m_handle.promise().m_stopped = true;
+                self->m_stop_bridge.detach();
+
+                exec::set_stopped(std::move(self->m_receiver));
+            }
+
+            std::coroutine_handle<promise_type> m_handle;
+            ReceiverT m_receiver;
+            details::stop_token_bridge<stop_token_of_t<env_of_t<ReceiverT>>> m_stop_bridge{};
+
+        };
+
+        explicit async_generator(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) {}
+
+        std::coroutine_handle<promise_type> m_handle;
+
+    };
+}
+
+#endif // !EXEC_ASYNC_GENERATOR_HPP
\ No newline at end of file
@@ -0,0 +1,144 @@
+#ifndef EXEC_BULK_HPP
+#define EXEC_BULK_HPP
+
+#include "exec/completions.hpp"
+#include "exec/completion_signatures.hpp"
+#include "exec/env.hpp"
+#include "exec/scheduler.hpp"
+#include "exec/sender.hpp"
+#include "exec/sender_adapter_closure.hpp"
+
+#include "exec/details/basic_closure.hpp"
+#include "exec/details/basic_sender.hpp"
+#include "exec/details/gather_signatures.hpp"
+#include "exec/details/meta_bind.hpp"
+#include "exec/details/meta_filter.hpp"
+#include "exec/details/meta_merge.hpp"
+#include "exec/details/product_type.hpp"
+#include "exec/details/signature_info.hpp"
+#include "exec/details/type_list.hpp"
+
+#include <concepts>
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace exec {
+    struct bulk_t;
+
+    namespace details {
+        template<std::integral ShapeT, typename InvocableT>
+        struct bulk_data {
+            ShapeT shape;
+            InvocableT invocable;
+        };
+
+        // A scheduler customizes bulk by providing `schd.bulk(sender, shape, invocable)`, it is picked when the
+        // input sender advertises that scheduler as its value completion scheduler.
+        template<typename SenderT, typename ShapeT, typename InvocableT>
+        concept scheduler_bulk =
+            requires(SenderT&& input, ShapeT shape, InvocableT&& invocable) {
+                get_completion_scheduler<set_value_t>(exec::get_env(input)).bulk(
+                    std::forward<SenderT>(input), shape, std::forward<InvocableT>(invocable));
+            };
+    }
+
+    template<>
+    struct details::impls_for<bulk_t> : default_impls {
+        template<typename ShapeT, typename InvocableT, typename... ArgTs>
+        using is_nothrow_t =
+            std::bool_constant<std::is_nothrow_invocable_v<InvocableT&, ShapeT, std::decay_t<ArgTs>&...>>;
+
+        template<typename ShapeT, typename InvocableT>
+        struct is_nothrow_bulk {
+            template<typename... SigTs>
+            using type =
+                std::bool_constant<(signature_args_of<completion_signatures<SigTs>>::template apply<
+                                        meta_bind_front<is_nothrow_t, ShapeT, InvocableT>::template type
+                                    >::value && ... && true)>;
+        };
+
+        template<typename SenderT, typename EnvT>
+        static constexpr bool is_nothrow_v =
+            []() consteval {
+                using data_t = std::remove_cvref_t<data_of_t<SenderT>>;
+                using child_sender_t = decltype(std::forward_like<SenderT>(std::declval<child_of_t<SenderT, 0>>()));
+                using value_signatures_t =
+                    meta_filter_t<set_value_t, completion_signatures_of_t<child_sender_t, EnvT>, has_same_tag>;
+
+                return elements_of<value_signatures_t>::template apply<
+                    is_nothrow_bulk<decltype(data_t::shape), decltype(data_t::invocable)>::template type
+                >::value;
+            }();
+
+        static constexpr auto get_completion_signatures =
+            []<typename SenderT, typename EnvT>(SenderT&&, EnvT&&) noexcept {
+                using child_sender_t = decltype(std::forward_like<SenderT>(std::declval<child_of_t<SenderT, 0>>()));
+                using child_completion_signatures_t = completion_signatures_of_t<child_sender_t, EnvT>;
+
+                if constexpr (is_nothrow_v<SenderT, EnvT>) {
+                    return child_completion_signatures_t{};
+                }
+                else {
+                    return meta_merge_t<child_completion_signatures_t,
+                                        completion_signatures<exec::set_error_t(std::exception_ptr)>>{};
+                }
+            };
+
+        static constexpr auto complete =
+            []<typename DataT, typename ReceiverT, typename TagT, typename... ArgTs>
+                (auto, DataT& data, ReceiverT& receiver, TagT, ArgTs&&... args) noexcept -> void
+            {
+                if constexpr (std::is_same_v<TagT, exec::set_value_t>) {
+                    constexpr bool nothrow = std::is_nothrow_invocable_v<decltype((data.invocable)),
+                                                                         decltype(data.shape),
+                                                                         std::decay_t<ArgTs>&...>;
+
+                    try {
+                        for (decltype(data.shape) i = 0; i < data.shape; ++i) {
+                            std::invoke(data.invocable, i, args...);
+                        }
+                    }
+                    catch (...) {
+                        if constexpr (!nothrow) {
+                            exec::set_error(std::move(receiver), std::current_exception());
+                            return;
+                        }
+                    }
+
+                    exec::set_value(std::move(receiver), std::forward<ArgTs>(args)...);
+                }
+                else {
+                    TagT{}(std::move(receiver), std::forward<ArgTs>(args)...);
+                }
+            };
+    };
+
+    struct bulk_t {
+        template<sender SenderT, std::integral ShapeT, typename InvocableT>
+        [[nodiscard]] constexpr auto operator()(SenderT&& input, ShapeT shape, InvocableT&& invocable) const {
+            if constexpr (details::scheduler_bulk<SenderT, ShapeT, InvocableT>) {
+                return get_completion_scheduler<set_value_t>(exec::get_env(input)).bulk(
+                    std::forward<SenderT>(input), shape, std::forward<InvocableT>(invocable));
+            }
+            else {
+                return details::make_sender(
+                    *this,
+                    details::bulk_data<ShapeT, std::decay_t<InvocableT>>{ shape, std::forward<InvocableT>(invocable) },
+                    std::forward<SenderT>(input));
+            }
+        }
+
+        template<std::integral ShapeT, typename InvocableT>
+        [[nodiscard]] constexpr auto operator()(ShapeT shape, InvocableT&& invocable) const {
+            return details::basic_closure{
+                sender_adapter_closure<bulk_t>{},
+                details::product_type{ shape, std::forward<InvocableT>(invocable) }
+            };
+        }
+    };
+    inline constexpr bulk_t bulk{};
+}
+
+#endif // !EXEC_BULK_HPP
\ No newline at end of file
@@ -1,14 +1,19 @@
 #ifndef EXEC_COUNTING_SCOPES_HPP
 #define EXEC_COUNTING_SCOPES_HPP
 
+#include "exec/allocator.hpp"
+#include "exec/pool_allocator.hpp"
 #include "exec/sender.hpp"
 #include "exec/stop_token.hpp"
 
 #include "exec/details/association.hpp"
 #include "exec/details/counting_scope_state.hpp"
 #include "exec/details/scope_join.hpp"
+#include "exec/details/sharded_counting_scope_state.hpp"
 #include "exec/details/stop_when.hpp"
 
+#include <cstddef>
+
 namespace exec {
     class simple_counting_scope {
     public:
@@ -153,6 +158,88 @@ namespace exec {
         inplace_stop_source m_stop_source;
 
     };
+
+    // A counting_scope whose association counts are kept in per-thread shards, so that spawning from many threads
+    // does not contend on a single counter. The shards are only aggregated when the scope is joined.
+    class sharded_counting_scope {
+    public:
+        using assoc_t = details::sharded_association_t<sharded_counting_scope>;
+
+        class token {
+        public:
+            template<sender SenderT>
+            [[nodiscard]] sender auto wrap(SenderT&& sender) const
+                noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<SenderT>, SenderT>)
+            {
+                return details::stop_when(std::forward<SenderT>(sender), m_scope->m_stop_source.get_token());
+            }
+
+            [[nodiscard]] assoc_t try_associate() const noexcept {
+                return m_scope->try_associate();
+            }
+
+            // Operations spawned on this scope are allocated from the thread caching pool by default.
+            [[nodiscard]] static constexpr pool_allocator<std::byte> query(get_allocator_t) noexcept {
+                return {};
+            }
+
+        private:
+            friend class sharded_counting_scope;
+
+            explicit token(sharded_counting_scope* scope) noexcept :
+                m_scope(scope) {}
+
+            sharded_counting_scope* m_scope;
+
+        };
+
+        static constexpr std::size_t max_associations = details::sharded_counting_scope_state::max_associations;
+
+        sharded_counting_scope() = default;
+
+        ~sharded_counting_scope() noexcept = default;
+
+        sharded_counting_scope(sharded_counting_scope&&) = delete;
+
+        [[nodiscard]] token get_token() noexcept {
+            return token{ this };
+        }
+
+        void close() noexcept {
+            m_state.close();
+        }
+
+        [[nodiscard]] sender auto join() noexcept {
+            return details::scope_join(this);
+        }
+
+        void request_stop() noexcept {
+            m_stop_source.request_stop();
+        }
+
+    private:
+        friend class token;
+        friend struct details::impls_for<details::scope_join_t>;
+        friend struct details::sharded_association_t<sharded_counting_scope>;
+
+        [[nodiscard]] assoc_t try_associate() noexcept {
+            const std::size_t shard = m_state.this_shard();
+            return m_state.try_associate(shard) ? assoc_t{ this, shard } : assoc_t{};
+        }
+
+        void disassociate(std::size_t shard) noexcept {
+            m_state.disassociate(shard);
+        }
+
+        template<typename StateT>
+        [[nodiscard]] bool try_start_join(StateT& state) {
+            return m_state.try_start_join(state);
+        }
+
+        details::sharded_counting_scope_state m_state;
+        inplace_stop_source m_stop_source;
+
+    };
 }
 
 #endif // !EXEC_COUNTING_SCOPES_HPP
\ No newline at end of file
@@ -3,7 +3,9 @@
 
 #include "exec/scope_token.hpp"
 
+#include <cstddef>
 #include <type_traits>
+#include <utility>
 
 namespace exec::details {
     template<typename ScopeT>
@@ -45,6 +47,50 @@ namespace exec::details {
 
     };
 
+    // Association with a scope that also records the shard it was counted on, it is released on the same shard.
+    template<typename ScopeT>
+    struct sharded_association_t {
+        ScopeT* scope{ nullptr };
+        std::size_t shard{ 0 };
+
+        sharded_association_t() = default;
+
+        sharded_association_t(ScopeT* scope, std::size_t shard) noexcept : scope(scope), shard(shard) {}
+
+        sharded_association_t(const sharded_association_t&) noexcept = delete;
+
+        sharded_association_t& operator=(const sharded_association_t&) noexcept = delete;
+
+        sharded_association_t(sharded_association_t&& other) noexcept :
+            scope(std::exchange(other.scope, nullptr)),
+            shard(other.shard) {}
+
+        sharded_association_t& operator=(sharded_association_t&& other) noexcept {
+            scope = std::exchange(other.scope, nullptr);
+            shard = other.shard;
+            return *this;
+        }
+
+        ~sharded_association_t() noexcept {
+            if (scope != nullptr) {
+                scope->disassociate(shard);
+            }
+        }
+
+        [[nodiscard]] sharded_association_t try_associate() const {
+            if (scope != nullptr) {
+                return scope->try_associate();
+            }
+
+            return {};
+        }
+
+        [[nodiscard]] constexpr operator bool() const noexcept {
+            return scope != nullptr;
+        }
+
+    };
+
     template<scope_token T>
     using association_of_t = std::remove_cvref_t<decltype(std::declval<std::remove_cvref_t<T>&>().try_associate())>;
 }
@@ -0,0 +1,48 @@
+#ifndef EXEC_DETAILS_ATOMIC_INTRUSIVE_QUEUE_HPP
+#define EXEC_DETAILS_ATOMIC_INTRUSIVE_QUEUE_HPP
+
+#include "exec/details/intrusive_queue.hpp"
+
+#include <atomic>
+
+namespace exec::details {
+    template<typename NodeT>
+    class atomic_intrusive_queue {
+    public:
+        atomic_intrusive_queue() noexcept = default;
+
+        atomic_intrusive_queue(const atomic_intrusive_queue&) = delete;
+        atomic_intrusive_queue& operator=(const atomic_intrusive_queue&) = delete;
+
+        // Returns true if the queue was empty before the push.
+        bool push(NodeT* node) noexcept {
+            auto* head = m_head.load(std::memory_order_relaxed);
+            do {
+                node->next = head;
+            } while (!m_head.compare_exchange_weak(head,
+                                                   node,
+                                                   std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed));
+
+            return head == nullptr;
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return m_head.load(std::memory_order_seq_cst) == nullptr;
+        }
+
+        [[nodiscard]] intrusive_queue<NodeT> pop_all() noexcept {
+            if (m_head.load(std::memory_order_relaxed) == nullptr) {
+                return {};
+            }
+
+            return intrusive_queue<NodeT>::make_reversed(m_head.exchange(nullptr, std::memory_order_acquire));
+        }
+
+    private:
+        std::atomic<NodeT*> m_head{ nullptr };
+
+    };
+}
+
+#endif // !EXEC_DETAILS_ATOMIC_INTRUSIVE_QUEUE_HPP
\ No newline at end of file
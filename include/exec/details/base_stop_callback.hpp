@@ -13,8 +13,7 @@ namespace exec::details {
 
         virtual void invoke() noexcept = 0;
 
-        base_stop_callback* pop() noexcept {
-            auto* const local_prev = prev;
+        void pop() noexcept {
             bool local_deleted_flag = false;
 
             deleted = &local_deleted_flag;
@@ -25,11 +24,8 @@ namespace exec::details {
                 deleted = nullptr;
                 invoked.store(true, std::memory_order_release);
             }
-
-            return local_prev;
         }
 
-        base_stop_callback* next{ nullptr };
         base_stop_callback* prev{ nullptr };
 
         bool* deleted{ nullptr };
@@ -6,11 +6,15 @@
 #include "exec/operation_state.hpp"
 #include "exec/receiver.hpp"
 #include "exec/sender.hpp"
+#include "exec/tracer.hpp"
 
 #include "exec/details/forward_env.hpp"
 #include "exec/details/product_type.hpp"
+#include "exec/details/thread_index.hpp"
+#include "exec/details/type_name.hpp"
 
 #include <concepts>
+#include <cstdint>
 #include <type_traits>
 #include <utility>
 
@@ -76,6 +80,23 @@ namespace exec::details {
     template<typename SenderT>
     using indices_for = std::remove_reference_t<SenderT>::indices_for;
 
+    // Calls `fn` and reports it to the tracer in the receiver's env, a receiver without one gets the plain call. The
+    // tracer is copied beforehand, as the operation may already be destroyed when `fn` returns.
+    template<typename TagT, typename ReceiverT, typename FnT>
+    void traced_call(trace_phase phase, const ReceiverT& receiver, FnT&& fn) noexcept {
+        if constexpr (has_query<env_of_t<ReceiverT>, get_tracer_t>) {
+            auto tracer = get_tracer(exec::get_env(receiver));
+            const std::int64_t begin = trace_now();
+
+            std::forward<FnT>(fn)();
+
+            tracer.record(trace_event{ type_name<TagT>, phase, thread_index(), begin, trace_now() });
+        }
+        else {
+            std::forward<FnT>(fn)();
+        }
+    }
+
     template<typename SenderT, typename ReceiverT>
     struct basic_state {
         basic_state(SenderT&& sndr, ReceiverT&& rcvr)
@@ -102,19 +123,25 @@ namespace exec::details {
         template<typename... Ts>
         requires std::invocable<decltype(complete), IndexT, state_t&, ReceiverT&, exec::set_value_t, Ts...>
         void set_value(Ts&&... values) && noexcept {
-            complete(IndexT(), op->state, op->receiver, exec::set_value_t{}, std::forward<Ts>(values)...);
+            traced_call<tag_t>(trace_phase::set_value, op->receiver, [&]() noexcept {
+                complete(IndexT(), op->state, op->receiver, exec::set_value_t{}, std::forward<Ts>(values)...);
+            });
         }
 
         template<typename T>
         requires std::invocable<decltype(complete), IndexT, state_t&, ReceiverT&, exec::set_error_t, T>
         void set_error(T&& value) && noexcept {
-            complete(IndexT(), op->state, op->receiver, exec::set_error_t{}, std::forward<T>(value));
+            traced_call<tag_t>(trace_phase::set_error, op->receiver, [&]() noexcept {
+                complete(IndexT(), op->state, op->receiver, exec::set_error_t{}, std::forward<T>(value));
+            });
         }
 
         void set_stopped() && noexcept
             requires std::invocable<decltype(complete), IndexT, state_t&, ReceiverT&, exec::set_stopped_t>
         {
-            complete(IndexT(), op->state, op->receiver, exec::set_stopped_t{});
+            traced_call<tag_t>(trace_phase::set_stopped, op->receiver, [this]() noexcept {
+                complete(IndexT(), op->state, op->receiver, exec::set_stopped_t{});
+            });
         }
 
         [[nodiscard]] constexpr env_from_tag_t<IndexT, SenderT, ReceiverT> get_env() const noexcept {
@@ -152,8 +179,10 @@ namespace exec::details {
                 inner(connect_all(this, std::forward<SenderT>(sender), indices_for<SenderT>{})) {}
 
         void start() & noexcept {
-            inner.apply([this]<typename... ArgTs>(ArgTs&... args) mutable noexcept {
-                impls_for<tag_t>::start(this->state, this->receiver, args...);
+            traced_call<tag_t>(trace_phase::start, this->receiver, [this]() noexcept {
+                inner.apply([this]<typename... ArgTs>(ArgTs&... args) mutable noexcept {
+                    impls_for<tag_t>::start(this->state, this->receiver, args...);
+                });
             });
         }
 
@@ -67,17 +67,39 @@ namespace exec::details {
         }
 
         void disassociate() noexcept {
+            remove(1);
+        }
+
+        // Moves `count` existing associations into this state, fails once it is joined.
+        [[nodiscard]] bool try_transfer(std::size_t count) noexcept {
+            std::size_t expected = m_state.load(std::memory_order_relaxed);
+            std::size_t desired = 0;
+            do {
+                if (is_joined(expected)) {
+                    return false;
+                }
+
+                desired = (get_count(expected) + count) << 3 | get_state(expected) | scope_state_flags::Used;
+            } while (!m_state.compare_exchange_weak(expected,
+                                                    desired,
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_relaxed));
+
+            return true;
+        }
+
+        void remove(std::size_t count) noexcept {
             std::size_t expected = m_state.load(std::memory_order_relaxed);
             std::size_t desired = 0;
             do {
-                assert(get_count(expected) != 0);
+                assert(get_count(expected) >= count);
                 assert(!is_joined(expected));
 
-                if (is_joining(expected) && get_count(expected) == 1) {
+                if (is_joining(expected) && get_count(expected) == count) {
                     desired = scope_state_flags::Joined;
                 }
                 else {
-                    desired = (get_count(expected) - 1) << 3 | get_state(expected);
+                    desired = (get_count(expected) - count) << 3 | get_state(expected);
                 }
             } while (!m_state.compare_exchange_weak(expected,
                                                     desired,
@@ -87,7 +109,8 @@ namespace exec::details {
             if (is_joined(desired)) {
                 auto* local_head = m_head.exchange(nullptr, std::memory_order_acq_rel);
 
-                while (local_head != nullptr) {
+                // The last waiter to complete may destroy the scope, the dummy head must not be touched after it.
+                while (local_head != std::addressof(m_dummy_head)) {
                     auto* const state = std::exchange(local_head, local_head->prev);
 
                     state->complete();
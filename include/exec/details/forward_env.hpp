@@ -13,7 +13,7 @@ namespace exec::details {
     template<typename EnvT>
     struct forwarding_env : EnvT {
         template<typename QueryT>
-        requires is_forwarding_query<QueryT>
+        requires is_forwarding_query<QueryT> && requires(const EnvT& env) { env.query(QueryT{}); }
         [[nodiscard]] constexpr decltype(auto) query(QueryT) const noexcept {
             return static_cast<const EnvT&>(*this).query(QueryT{});
         }
@@ -31,8 +31,10 @@ namespace exec::details {
     template<typename T>
     concept valid_forwarding_env = is_forwarding_env<std::remove_cvref_t<T>>::value;
 
+    // An env that already forwards is passed through, by reference when it is an lvalue and by value otherwise, a
+    // reference to the temporary returned by get_env would dangle once the env is handed to the next receiver.
     template<valid_forwarding_env EnvT>
-    constexpr decltype(auto) forward_env(EnvT&& env) noexcept {
+    constexpr EnvT forward_env(EnvT&& env) noexcept {
         return std::forward<EnvT>(env);
     }
 
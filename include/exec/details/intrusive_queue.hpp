@@ -0,0 +1,102 @@
+#ifndef EXEC_DETAILS_INTRUSIVE_QUEUE_HPP
+#define EXEC_DETAILS_INTRUSIVE_QUEUE_HPP
+
+#include <cstddef>
+#include <utility>
+
+namespace exec::details {
+    template<typename NodeT>
+    class intrusive_queue {
+    public:
+        intrusive_queue() noexcept = default;
+
+        intrusive_queue(intrusive_queue&& other) noexcept :
+            m_head(std::exchange(other.m_head, nullptr)),
+            m_tail(std::exchange(other.m_tail, nullptr)) {}
+
+        intrusive_queue& operator=(intrusive_queue&& other) noexcept {
+            m_head = std::exchange(other.m_head, nullptr);
+            m_tail = std::exchange(other.m_tail, nullptr);
+            return *this;
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return m_head == nullptr;
+        }
+
+        void push_back(NodeT* node) noexcept {
+            node->next = nullptr;
+
+            if (m_tail == nullptr) {
+                m_head = node;
+            }
+            else {
+                m_tail->next = node;
+            }
+
+            m_tail = node;
+        }
+
+        void push_front(NodeT* node) noexcept {
+            node->next = m_head;
+            m_head = node;
+
+            if (m_tail == nullptr) {
+                m_tail = node;
+            }
+        }
+
+        void append(intrusive_queue other) noexcept {
+            if (other.empty()) {
+                return;
+            }
+
+            if (m_tail == nullptr) {
+                m_head = other.m_head;
+            }
+            else {
+                m_tail->next = other.m_head;
+            }
+
+            m_tail = other.m_tail;
+            other.m_head = nullptr;
+            other.m_tail = nullptr;
+        }
+
+        [[nodiscard]] NodeT* pop_front() noexcept {
+            auto* const node = m_head;
+            if (node == nullptr) {
+                return nullptr;
+            }
+
+            m_head = static_cast<NodeT*>(node->next);
+            if (m_head == nullptr) {
+                m_tail = nullptr;
+            }
+
+            return node;
+        }
+
+        // Builds a FIFO queue from a LIFO chain linked through `next`, as produced by an atomic stack.
+        [[nodiscard]] static intrusive_queue make_reversed(NodeT* stack) noexcept {
+            intrusive_queue result;
+            result.m_tail = stack;
+
+            while (stack != nullptr) {
+                auto* const next = static_cast<NodeT*>(stack->next);
+                stack->next = result.m_head;
+                result.m_head = stack;
+                stack = next;
+            }
+
+            return result;
+        }
+
+    private:
+        NodeT* m_head{ nullptr };
+        NodeT* m_tail{ nullptr };
+
+    };
+}
+
+#endif // !EXEC_DETAILS_INTRUSIVE_QUEUE_HPP
\ No newline at end of file
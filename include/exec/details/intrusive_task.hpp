@@ -0,0 +1,19 @@
+#ifndef EXEC_DETAILS_INTRUSIVE_TASK_HPP
+#define EXEC_DETAILS_INTRUSIVE_TASK_HPP
+
+namespace exec::details {
+    struct intrusive_task {
+        using execute_fn = void(intrusive_task*) noexcept;
+
+        explicit intrusive_task(execute_fn* execute) noexcept : execute_ptr(execute) {}
+
+        void execute() noexcept {
+            execute_ptr(this);
+        }
+
+        intrusive_task* next{ nullptr };
+        execute_fn* execute_ptr;
+    };
+}
+
+#endif // !EXEC_DETAILS_INTRUSIVE_TASK_HPP
\ No newline at end of file
@@ -0,0 +1,182 @@
+#ifndef EXEC_DETAILS_IO_URING_RING_HPP
+#define EXEC_DETAILS_IO_URING_RING_HPP
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+
+namespace exec::details {
+    // Minimal io_uring binding on raw syscalls. Single threaded: SQEs are filled by the owner and published in one
+    // io_uring_enter call, completions are reaped by the same thread.
+    class io_uring_ring {
+    public:
+        explicit io_uring_ring(unsigned entries) {
+            ::io_uring_params params{};
+
+            m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+            if (m_fd < 0) {
+                throw std::system_error(errno, std::system_category(), "io_uring_setup failed.");
+            }
+
+            m_sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            m_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe);
+            m_sqes_size = params.sq_entries * sizeof(::io_uring_sqe);
+
+            const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single_mmap) {
+                m_sq_size = m_cq_size = std::max(m_sq_size, m_cq_size);
+            }
+
+            m_sq_ring = map(m_sq_size, IORING_OFF_SQ_RING);
+            m_cq_ring = single_mmap ? m_sq_ring : map(m_cq_size, IORING_OFF_CQ_RING);
+            m_sqes = static_cast<::io_uring_sqe*>(map(m_sqes_size, IORING_OFF_SQES));
+
+            if (m_sq_ring == nullptr || m_cq_ring == nullptr || m_sqes == nullptr) {
+                const int error = errno;
+                release();
+                throw std::system_error(error, std::system_category(), "io_uring mmap failed.");
+            }
+
+            auto* const sq = static_cast<std::byte*>(m_sq_ring);
+            m_sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+            m_sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            m_sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            m_sq_entries = params.sq_entries;
+
+            auto* const cq = static_cast<std::byte*>(m_cq_ring);
+            m_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            m_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            m_cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            m_cqes = reinterpret_cast<::io_uring_cqe*>(cq + params.cq_off.cqes);
+
+            m_local_tail = *m_sq_tail;
+        }
+
+        io_uring_ring(io_uring_ring&&) = delete;
+
+        ~io_uring_ring() noexcept {
+            release();
+        }
+
+        // Returns a zeroed SQE, or nullptr when the submission queue is full and has to be flushed first.
+        [[nodiscard]] ::io_uring_sqe* try_get_sqe() noexcept {
+            const unsigned head = std::atomic_ref(*m_sq_head).load(std::memory_order_acquire);
+            if (m_local_tail - head >= m_sq_entries) {
+                return nullptr;
+            }
+
+            const unsigned index = m_local_tail & m_sq_mask;
+            m_sq_array[index] = index;
+            ++m_local_tail;
+
+            auto* const sqe = &m_sqes[index];
+            std::memset(sqe, 0, sizeof(::io_uring_sqe));
+
+            return sqe;
+        }
+
+        [[nodiscard]] bool has_pending() const noexcept {
+            return m_local_tail != std::atomic_ref(*m_sq_head).load(std::memory_order_acquire);
+        }
+
+        // Publishes every prepared SQE and optionally waits for `wait` completions, returns 0 or -errno.
+        int submit(unsigned wait) noexcept {
+            std::atomic_ref(*m_sq_tail).store(m_local_tail, std::memory_order_release);
+
+            const unsigned pending = m_local_tail - std::atomic_ref(*m_sq_head).load(std::memory_order_acquire);
+            if (pending == 0 && wait == 0) {
+                return 0;
+            }
+
+            const unsigned flags = wait > 0 ? IORING_ENTER_GETEVENTS : 0u;
+            const long result = ::syscall(__NR_io_uring_enter, m_fd, pending, wait, flags, nullptr, 0);
+
+            return result < 0 ? -errno : 0;
+        }
+
+        // Invokes `callback(user_data, res)` for every available CQE.
+        template<typename CallbackT>
+        std::size_t reap(CallbackT&& callback) noexcept {
+            std::size_t count = 0;
+            unsigned head = *m_cq_head;
+
+            while (head != std::atomic_ref(*m_cq_tail).load(std::memory_order_acquire)) {
+                const auto& cqe = m_cqes[head & m_cq_mask];
+                const std::uint64_t user_data = cqe.user_data;
+                const std::int32_t res = cqe.res;
+
+                std::atomic_ref(*m_cq_head).store(++head, std::memory_order_release);
+                ++count;
+
+                callback(user_data, res);
+            }
+
+            return count;
+        }
+
+    private:
+        [[nodiscard]] void* map(std::size_t size, std::uint64_t offset) const noexcept {
+            void* const ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd,
+                                     static_cast<::off_t>(offset));
+
+            return ptr == MAP_FAILED ? nullptr : ptr;
+        }
+
+        void release() noexcept {
+            if (m_sqes != nullptr) {
+                ::munmap(m_sqes, m_sqes_size);
+            }
+
+            if (m_cq_ring != nullptr && m_cq_ring != m_sq_ring) {
+                ::munmap(m_cq_ring, m_cq_size);
+            }
+
+            if (m_sq_ring != nullptr) {
+                ::munmap(m_sq_ring, m_sq_size);
+            }
+
+            if (m_fd >= 0) {
+                ::close(m_fd);
+            }
+        }
+
+        int m_fd{ -1 };
+
+        void* m_sq_ring{ nullptr };
+        void* m_cq_ring{ nullptr };
+        ::io_uring_sqe* m_sqes{ nullptr };
+
+        std::size_t m_sq_size{ 0 };
+        std::size_t m_cq_size{ 0 };
+        std::size_t m_sqes_size{ 0 };
+
+        unsigned* m_sq_head{ nullptr };
+        unsigned* m_sq_tail{ nullptr };
+        unsigned* m_sq_array{ nullptr };
+        unsigned m_sq_mask{ 0 };
+        unsigned m_sq_entries{ 0 };
+        unsigned m_local_tail{ 0 };
+
+        unsigned* m_cq_head{ nullptr };
+        unsigned* m_cq_tail{ nullptr };
+        ::io_uring_cqe* m_cqes{ nullptr };
+        unsigned m_cq_mask{ 0 };
+
+    };
+}
+
+#endif // __linux__ && __has_include(<linux/io_uring.h>)
+
+#endif // !EXEC_DETAILS_IO_URING_RING_HPP
\ No newline at end of file
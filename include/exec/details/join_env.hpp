@@ -10,6 +10,8 @@ namespace exec::details {
     template<queryable LEnv, queryable REnv>
     struct joined_env : LEnv, REnv {
         template<typename QueryT>
+        requires requires { std::declval<const LEnv&>().query(QueryT{}); } ||
+                 requires { std::declval<const REnv&>().query(QueryT{}); }
         [[nodiscard]] constexpr decltype(auto) query(QueryT) const noexcept {
             if constexpr (requires { std::declval<const LEnv&>().query(QueryT{}); }) {
                 return static_cast<const LEnv&>(*this).query(QueryT{});
@@ -0,0 +1,71 @@
+#ifndef EXEC_DETAILS_REFCOUNTED_STOP_STATE_HPP
+#define EXEC_DETAILS_REFCOUNTED_STOP_STATE_HPP
+
+#include "exec/details/stop_state.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace exec::details {
+    // Stop state shared by stop_source, stop_token and stop_callback. The reference count lives in the same cache
+    // line as the state, and the whole object comes from a single allocation made with the source's allocator.
+    struct alignas(64) refcounted_stop_state : stop_state {
+        using destroy_t = void (*)(refcounted_stop_state*) noexcept;
+
+        explicit refcounted_stop_state(destroy_t destroy) noexcept : m_destroy(destroy) {}
+
+        refcounted_stop_state(refcounted_stop_state&&) = delete;
+
+        void add_ref() noexcept {
+            m_refcount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void release() noexcept {
+            if (m_refcount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                m_destroy(this);
+            }
+        }
+
+        template<typename AllocT>
+        [[nodiscard]] static refcounted_stop_state* make(const AllocT& alloc);
+
+        std::atomic_size_t m_refcount{ 1 };
+        destroy_t m_destroy;
+    };
+
+    template<typename AllocT>
+    struct allocated_stop_state final : refcounted_stop_state {
+        using traits_t = std::allocator_traits<AllocT>::template rebind_traits<allocated_stop_state>;
+        using alloc_t = traits_t::allocator_type;
+
+        explicit allocated_stop_state(const alloc_t& alloc) noexcept :
+            refcounted_stop_state(&allocated_stop_state::destroy),
+            m_alloc(alloc) {}
+
+        static void destroy(refcounted_stop_state* state) noexcept {
+            auto* const self = static_cast<allocated_stop_state*>(state);
+            alloc_t alloc(std::move(self->m_alloc));
+
+            traits_t::destroy(alloc, self);
+            traits_t::deallocate(alloc, self, 1);
+        }
+
+        [[no_unique_address]] alloc_t m_alloc;
+    };
+
+    template<typename AllocT>
+    refcounted_stop_state* refcounted_stop_state::make(const AllocT& source_alloc) {
+        using state_t = allocated_stop_state<AllocT>;
+        using traits_t = state_t::traits_t;
+
+        typename traits_t::allocator_type alloc(source_alloc);
+        state_t* const state = traits_t::allocate(alloc, 1);
+        traits_t::construct(alloc, state, alloc);
+
+        return state;
+    }
+}
+
+#endif // !EXEC_DETAILS_REFCOUNTED_STOP_STATE_HPP
\ No newline at end of file
@@ -0,0 +1,162 @@
+#ifndef EXEC_DETAILS_SENDER_AWAITABLE_HPP
+#define EXEC_DETAILS_SENDER_AWAITABLE_HPP
+
+#include "exec/completions.hpp"
+#include "exec/completion_signatures.hpp"
+#include "exec/env.hpp"
+#include "exec/operation_state.hpp"
+#include "exec/receiver.hpp"
+#include "exec/sender.hpp"
+
+#include "exec/details/gather_signatures.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace exec::details {
+    template<typename... Ts>
+    struct await_value {
+        using type = std::tuple<std::decay_t<Ts>...>;
+    };
+
+    template<>
+    struct await_value<> {
+        using type = void;
+    };
+
+    template<typename T>
+    struct await_value<T> {
+        using type = std::decay_t<T>;
+    };
+
+    template<typename... Ts>
+    using await_value_t = await_value<Ts...>::type;
+
+    template<typename... Ts>
+    struct single_await_value {
+        static_assert(sizeof...(Ts) <= 1, "Only senders with at most one value completion can be awaited.");
+
+        using type = void;
+    };
+
+    template<typename T>
+    struct single_await_value<T> {
+        using type = T;
+    };
+
+    template<typename... Ts>
+    using single_await_value_t = single_await_value<Ts...>::type;
+
+    template<typename SenderT, typename EnvT>
+    using await_result_t =
+        gather_signatures<exec::set_value_t, completion_signatures_of_t<SenderT, EnvT>, await_value_t, single_await_value_t>;
+
+    // Awaiter connecting a sender to the awaiting coroutine. A completion that happens before await_suspend returns
+    // is picked up there and transferred to symmetrically, so synchronous senders never grow the stack. A stopped
+    // completion never resumes the awaiting coroutine, control goes to its promise's unhandled_stopped() instead.
+    template<typename SenderT, typename PromiseT>
+    class sender_awaitable {
+        using env_t = env_of_t<PromiseT&>;
+        using value_t = await_result_t<SenderT, env_t>;
+        using stored_t = std::conditional_t<std::is_void_v<value_t>, std::tuple<>, value_t>;
+
+        struct receiver {
+            using receiver_concept = exec::receiver_t;
+
+            sender_awaitable* self;
+
+            template<typename... Ts>
+            void set_value(Ts&&... values) && noexcept {
+                try {
+                    self->m_result.template emplace<1>(std::forward<Ts>(values)...);
+                }
+                catch (...) {
+                    self->m_result.template emplace<2>(std::current_exception());
+                }
+
+                self->complete();
+            }
+
+            template<typename ErrorT>
+            void set_error(ErrorT&& error) && noexcept {
+                if constexpr (std::is_same_v<std::decay_t<ErrorT>, std::exception_ptr>) {
+                    self->m_result.template emplace<2>(std::forward<ErrorT>(error));
+                }
+                else {
+                    self->m_result.template emplace<2>(std::make_exception_ptr(std::forward<ErrorT>(error)));
+                }
+
+                self->complete();
+            }
+
+            void set_stopped() && noexcept {
+                self->m_stopped = true;
+                self->complete();
+            }
+
+            [[nodiscard]] constexpr env_t get_env() const noexcept {
+                return exec::get_env(self->m_continuation.promise());
+            }
+        };
+
+    public:
+        explicit sender_awaitable(SenderT&& sender, PromiseT& promise) :
+            m_continuation(std::coroutine_handle<PromiseT>::from_promise(promise)),
+            m_op(exec::connect(std::forward<SenderT>(sender), receiver{ this })) {}
+
+        sender_awaitable(sender_awaitable&&) = delete;
+
+        [[nodiscard]] static constexpr bool await_ready() noexcept {
+            return false;
+        }
+
+        [[nodiscard]] std::coroutine_handle<> await_suspend(std::coroutine_handle<PromiseT>) noexcept {
+            exec::start(m_op);
+
+            if (!m_completed.exchange(true, std::memory_order_acq_rel)) {
+                return std::noop_coroutine();
+            }
+
+            return next();
+        }
+
+        value_t await_resume() {
+            if (m_result.index() == 2) {
+                std::rethrow_exception(std::get<2>(std::move(m_result)));
+            }
+
+            if constexpr (!std::is_void_v<value_t>) {
+                return std::get<1>(std::move(m_result));
+            }
+        }
+
+    private:
+        [[nodiscard]] std::coroutine_handle<> next() noexcept {
+            if (m_stopped) {
+                return m_continuation.promise().unhandled_stopped();
+            }
+
+            return m_continuation;
+        }
+
+        void complete() noexcept {
+            if (m_completed.exchange(true, std::memory_order_acq_rel)) {
+                next().resume();
+            }
+        }
+
+        std::coroutine_handle<PromiseT> m_continuation;
+        std::atomic_bool m_completed{ false };
+        bool m_stopped{ false };
+        std::variant<std::monostate, stored_t, std::exception_ptr> m_result{};
+        connect_result_t<SenderT, receiver> m_op;
+
+    };
+}
+
+#endif // !EXEC_DETAILS_SENDER_AWAITABLE_HPP
\ No newline at end of file
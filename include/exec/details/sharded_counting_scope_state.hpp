@@ -0,0 +1,144 @@
+#ifndef EXEC_DETAILS_SHARDED_COUNTING_SCOPE_STATE_HPP
+#define EXEC_DETAILS_SHARDED_COUNTING_SCOPE_STATE_HPP
+
+#include "exec/details/counting_scope_state.hpp"
+#include "exec/details/thread_index.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace exec::details {
+    // Association counts are spread over cache line sized shards, each thread associating through the shard picked
+    // by its index. close() and try_start_join() go to the central counting_scope_state; a join first drains every
+    // shard into it, leaving the shard marked as drained so that later associations fall back to the central count.
+    struct sharded_counting_scope_state {
+        struct alignas(64) shard {
+            std::atomic_size_t count{ 0 };
+        };
+
+        static constexpr std::size_t drained = std::numeric_limits<std::size_t>::max();
+
+        static constexpr std::size_t max_associations = counting_scope_state::max_associations;
+
+        counting_scope_state m_central;
+        std::atomic_bool m_used;
+        std::size_t m_shard_count;
+        std::unique_ptr<shard[]> m_shards;
+
+        sharded_counting_scope_state() :
+            m_used{ false },
+            m_shard_count{ std::max(std::thread::hardware_concurrency(), 1u) },
+            m_shards{ std::make_unique<shard[]>(m_shard_count) } {}
+
+        ~sharded_counting_scope_state() noexcept {
+            if (m_used.load(std::memory_order_acquire) &&
+                !counting_scope_state::is_joined(m_central.m_state.load(std::memory_order_acquire)))
+            {
+                std::terminate();
+            }
+        }
+
+        sharded_counting_scope_state(const sharded_counting_scope_state&) = delete;
+
+        sharded_counting_scope_state& operator=(const sharded_counting_scope_state&) = delete;
+
+        sharded_counting_scope_state(sharded_counting_scope_state&&) = delete;
+
+        sharded_counting_scope_state& operator=(sharded_counting_scope_state&&) = delete;
+
+        [[nodiscard]] std::size_t this_shard() const noexcept {
+            return thread_index() % m_shard_count;
+        }
+
+        [[nodiscard]] bool try_associate(std::size_t index) noexcept {
+            const auto state = m_central.m_state.load(std::memory_order_acquire);
+            if (counting_scope_state::is_joined(state) || counting_scope_state::is_closed(state)) {
+                return false;
+            }
+
+            if (!m_used.load(std::memory_order_relaxed)) {
+                m_used.store(true, std::memory_order_relaxed);
+            }
+
+            std::atomic_size_t& count = m_shards[index].count;
+            std::size_t expected = count.load(std::memory_order_relaxed);
+            do {
+                if (expected == drained) {
+                    return m_central.try_associate();
+                }
+
+                if (expected >= max_associations) {
+                    return false;
+                }
+            } while (!count.compare_exchange_weak(expected,
+                                                  expected + 1,
+                                                  std::memory_order_acq_rel,
+                                                  std::memory_order_relaxed));
+
+            return true;
+        }
+
+        void disassociate(std::size_t index) noexcept {
+            std::atomic_size_t& count = m_shards[index].count;
+            std::size_t expected = count.load(std::memory_order_relaxed);
+            do {
+                if (expected == drained) {
+                    m_central.disassociate();
+                    return;
+                }
+
+                assert(expected > 0);
+            } while (!count.compare_exchange_weak(expected,
+                                                  expected - 1,
+                                                  std::memory_order_acq_rel,
+                                                  std::memory_order_relaxed));
+        }
+
+        void close() noexcept {
+            m_central.close();
+        }
+
+        template<typename StateT>
+        [[nodiscard]] bool try_start_join(StateT& state) {
+            drain();
+            return m_central.try_start_join(state);
+        }
+
+        // The count of a shard is moved to the central state before the shard is marked as drained, so that the
+        // central count never misses an association. If the shard changed meanwhile the moved count is given back.
+        void drain() noexcept {
+            for (std::size_t i = 0; i < m_shard_count; ++i) {
+                std::atomic_size_t& count = m_shards[i].count;
+                std::size_t expected = count.load(std::memory_order_acquire);
+
+                while (expected != drained) {
+                    if (expected != 0 && !m_central.try_transfer(expected)) {
+                        // Only a join that already drained every shard can have completed.
+                        break;
+                    }
+
+                    const std::size_t moved = expected;
+                    if (count.compare_exchange_weak(expected,
+                                                    drained,
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_acquire))
+                    {
+                        break;
+                    }
+
+                    if (moved != 0) {
+                        m_central.remove(moved);
+                    }
+                }
+            }
+        }
+    };
+}
+
+#endif // !EXEC_DETAILS_SHARDED_COUNTING_SCOPE_STATE_HPP
\ No newline at end of file
@@ -0,0 +1,430 @@
+#ifndef EXEC_DETAILS_SHARED_STATE_HPP
+#define EXEC_DETAILS_SHARED_STATE_HPP
+
+#include "exec/completions.hpp"
+#include "exec/completion_signatures.hpp"
+#include "exec/env.hpp"
+#include "exec/operation_state.hpp"
+#include "exec/receiver.hpp"
+#include "exec/sender.hpp"
+#include "exec/stop_token.hpp"
+
+#include "exec/details/basic_sender.hpp"
+#include "exec/details/decayed_tuple.hpp"
+#include "exec/details/meta_add.hpp"
+#include "exec/details/meta_bind.hpp"
+#include "exec/details/meta_merge.hpp"
+#include "exec/details/signature_info.hpp"
+#include "exec/details/type_list.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace exec::details {
+    struct shared_waiter {
+        virtual ~shared_waiter() = default;
+
+        virtual void complete() noexcept = 0;
+
+        shared_waiter* prev{ nullptr };
+    };
+
+    // Heap allocated state behind split and ensure_started. It is refcounted by the senders and operations that
+    // refer to it, plus one reference held while the wrapped operation runs. Waiters are linked on a list terminated
+    // by m_dummy_head whose head word also holds a Locked bit, taken to add a waiter or to unlink one whose consumer
+    // asked to stop. Completion waits for the bit to clear and swaps the head for 0, so later waiters complete from
+    // the cached result without being queued and a stop request racing it finds nothing left to unlink.
+    template<typename SenderT>
+    struct shared_state {
+        struct dummy_waiter : shared_waiter {
+            void complete() noexcept override {}
+        };
+
+        enum head_state : std::uintptr_t {
+            Locked = 1
+        };
+
+        enum class add_result : std::uint8_t {
+            added,
+            completed,
+            stopped
+        };
+
+        static_assert(alignof(shared_waiter) > Locked);
+
+        using env_t = prop<get_stop_token_t, inplace_stop_token>;
+
+        struct receiver {
+            using receiver_concept = exec::receiver_t;
+
+            shared_state* state;
+
+            template<typename... Ts>
+            void set_value(Ts&&... values) && noexcept {
+                state->complete(exec::set_value_t{}, std::forward<Ts>(values)...);
+            }
+
+            template<typename ErrorT>
+            void set_error(ErrorT&& error) && noexcept {
+                state->complete(exec::set_error_t{}, std::forward<ErrorT>(error));
+            }
+
+            void set_stopped() && noexcept {
+                state->complete(exec::set_stopped_t{});
+            }
+
+            [[nodiscard]] constexpr env_t get_env() const noexcept {
+                return { get_stop_token, state->m_stop_source.get_token() };
+            }
+        };
+
+        template<typename TagT, typename... ArgTs>
+        using decayed_signature_t = completion_signatures<TagT(std::decay_t<ArgTs>...)>;
+
+        template<typename SigT>
+        using as_decayed_t =
+            signature_args_of<completion_signatures<SigT>>::template apply<
+                meta_bind_front<decayed_signature_t,
+                                completion_tag_of_t<completion_signatures<SigT>>>::template type>;
+
+        template<typename... SigTs>
+        using decayed_signatures_t = meta_add_t<completion_signatures<>, as_decayed_t<SigTs>...>;
+
+        using result_signatures_t =
+            meta_merge_t<typename elements_of<completion_signatures_of_t<SenderT, env_t>>::template apply<
+                             decayed_signatures_t>,
+                         completion_signatures<exec::set_stopped_t(), exec::set_error_t(std::exception_ptr)>>;
+
+        template<typename SigT>
+        using as_tuple_t =
+            signature_args_of<completion_signatures<SigT>>::template apply<
+                meta_bind_front<decayed_tuple,
+                                completion_tag_of_t<completion_signatures<SigT>>>::template type>;
+
+        template<typename... SigTs>
+        using as_variant_t = std::variant<std::monostate, as_tuple_t<SigTs>...>;
+
+        using result_t = elements_of<result_signatures_t>::template apply<as_variant_t>;
+        using op_t = connect_result_t<SenderT, receiver>;
+
+        dummy_waiter m_dummy_head;
+        std::atomic_size_t m_refcount;
+        std::atomic_bool m_started;
+        std::atomic_uintptr_t m_head;
+        inplace_stop_source m_stop_source;
+        result_t m_result;
+        op_t m_op;
+
+        template<typename S>
+        explicit shared_state(S&& sender) :
+            m_refcount{ 1 },
+            m_started{ false },
+            m_head{ reinterpret_cast<std::uintptr_t>(&m_dummy_head) },
+            m_op(exec::connect(std::forward<S>(sender), receiver{ this })) {}
+
+        shared_state(shared_state&&) = delete;
+
+        void add_ref() noexcept {
+            m_refcount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void release() noexcept {
+            if (m_refcount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
+            }
+        }
+
+        void start() noexcept {
+            if (!m_started.exchange(true, std::memory_order_relaxed)) {
+                add_ref();
+                exec::start(m_op);
+            }
+        }
+
+        void request_stop() noexcept {
+            m_stop_source.request_stop();
+        }
+
+        // A stop callback that ran before the lock was taken found nothing to unlink, the request is seen here
+        // instead and the waiter is not linked.
+        template<typename TokenT>
+        [[nodiscard]] add_result try_add_waiter(shared_waiter& waiter, const TokenT& token) noexcept {
+            const std::uintptr_t head = lock();
+            if (head == 0) {
+                return add_result::completed;
+            }
+
+            if (token.stop_requested()) {
+                unlock(top(head));
+                return add_result::stopped;
+            }
+
+            waiter.prev = top(head);
+            unlock(std::addressof(waiter));
+
+            return add_result::added;
+        }
+
+        // Returns true if the waiter was unlinked before completion took the list, its owner then completes it.
+        [[nodiscard]] bool try_remove_waiter(shared_waiter& waiter) noexcept {
+            const std::uintptr_t head = lock();
+            if (head == 0) {
+                return false;
+            }
+
+            shared_waiter* above = nullptr;
+            for (auto* current = top(head); current != &m_dummy_head; current = current->prev) {
+                if (current == std::addressof(waiter)) {
+                    if (above == nullptr) {
+                        unlock(waiter.prev);
+                    }
+                    else {
+                        above->prev = waiter.prev;
+                        unlock(top(head));
+                    }
+
+                    return true;
+                }
+
+                above = current;
+            }
+
+            unlock(top(head));
+            return false;
+        }
+
+        template<typename TagT, typename... ArgTs>
+        void complete(TagT, ArgTs&&... args) noexcept {
+            using tuple_t = decayed_tuple<TagT, ArgTs...>;
+
+            try {
+                m_result.template emplace<tuple_t>(TagT{}, std::forward<ArgTs>(args)...);
+            }
+            catch (...) {
+                m_result.template emplace<std::tuple<exec::set_error_t, std::exception_ptr>>(
+                    exec::set_error_t{}, std::current_exception());
+            }
+
+            std::uintptr_t head = m_head.load(std::memory_order_relaxed);
+            for (;;) {
+                if ((head & Locked) != 0) {
+                    m_head.wait(head, std::memory_order_relaxed);
+                    head = m_head.load(std::memory_order_relaxed);
+                }
+                else if (m_head.compare_exchange_weak(head, 0, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+
+            auto* local_head = top(head);
+
+            while (local_head != nullptr) {
+                auto* const waiter = std::exchange(local_head, local_head->prev);
+
+                waiter->complete();
+            }
+
+            release();
+        }
+
+    private:
+        [[nodiscard]] static shared_waiter* top(std::uintptr_t head) noexcept {
+            return reinterpret_cast<shared_waiter*>(head & ~std::uintptr_t{ Locked });
+        }
+
+        // Returns the locked head, or 0 once completion has taken the list.
+        [[nodiscard]] std::uintptr_t lock() noexcept {
+            std::uintptr_t expected = m_head.load(std::memory_order_acquire);
+            for (;;) {
+                if (expected == 0) {
+                    return 0;
+                }
+
+                if ((expected & Locked) != 0) {
+                    m_head.wait(expected, std::memory_order_relaxed);
+                    expected = m_head.load(std::memory_order_acquire);
+                }
+                else if (m_head.compare_exchange_weak(expected,
+                                                      expected | Locked,
+                                                      std::memory_order_acquire,
+                                                      std::memory_order_acquire))
+                {
+                    return expected | Locked;
+                }
+            }
+        }
+
+        void unlock(shared_waiter* head) noexcept {
+            m_head.store(reinterpret_cast<std::uintptr_t>(head), std::memory_order_release);
+            m_head.notify_all();
+        }
+    };
+
+    template<typename SenderT>
+    class shared_handle {
+    public:
+        using state_t = shared_state<SenderT>;
+
+        static constexpr bool consume = false;
+
+        template<typename TagT, typename... ArgTs>
+        using signature_t = completion_signatures<TagT(const ArgTs&...)>;
+
+        explicit shared_handle(state_t* state) noexcept : m_state(state) {}
+
+        shared_handle(const shared_handle& other) noexcept : m_state(other.m_state) {
+            if (m_state != nullptr) {
+                m_state->add_ref();
+            }
+        }
+
+        shared_handle(shared_handle&& other) noexcept : m_state(std::exchange(other.m_state, nullptr)) {}
+
+        shared_handle& operator=(const shared_handle&) = delete;
+
+        shared_handle& operator=(shared_handle&&) = delete;
+
+        ~shared_handle() {
+            if (m_state != nullptr) {
+                m_state->release();
+            }
+        }
+
+        [[nodiscard]] state_t* operator->() const noexcept {
+            return m_state;
+        }
+
+        constexpr void connected() noexcept {}
+
+    private:
+        state_t* m_state;
+    };
+
+    struct shared_impls : default_impls {
+        template<typename HandleT, typename SigT>
+        using as_signature_t =
+            signature_args_of<completion_signatures<SigT>>::template apply<
+                meta_bind_front<HandleT::template signature_t,
+                                completion_tag_of_t<completion_signatures<SigT>>>::template type>;
+
+        template<typename HandleT>
+        struct signatures {
+            template<typename... SigTs>
+            using apply = meta_add_t<completion_signatures<>, as_signature_t<HandleT, SigTs>...>;
+        };
+
+        // A consumer asked to stop leaves the list and completes with set_stopped, the shared work keeps running for
+        // the others. The sole consumer of ensure_started also asks the work to stop.
+        template<typename HandleT, typename ReceiverT>
+        struct operation : shared_waiter {
+            struct on_stop {
+                operation* self;
+
+                void operator()() const noexcept {
+                    if (self->handle->try_remove_waiter(*self)) {
+                        self->complete_stopped();
+                    }
+                }
+            };
+
+            using add_result = HandleT::state_t::add_result;
+            using stop_token_t = stop_token_of_t<env_of_t<ReceiverT>>;
+            using stop_callback_t = typename stop_token_t::template callback_type<on_stop>;
+
+            HandleT handle;
+            ReceiverT& receiver;
+            std::optional<stop_callback_t> stop_callback{};
+
+            explicit operation(HandleT&& handle, ReceiverT& receiver) noexcept :
+                handle(std::move(handle)),
+                receiver(receiver) {
+                this->handle.connected();
+            }
+
+            explicit operation(const HandleT& handle, ReceiverT& receiver) noexcept :
+                handle(handle),
+                receiver(receiver) {
+                this->handle.connected();
+            }
+
+            operation(operation&&) = delete;
+
+            // Nothing is touched past a successful add, the result may complete and destroy the operation at once.
+            void run() noexcept {
+                handle->start();
+
+                auto token = get_stop_token(exec::get_env(receiver));
+                stop_callback.emplace(token, on_stop{ this });
+
+                switch (handle->try_add_waiter(*this, token)) {
+                    case add_result::added:
+                        break;
+                    case add_result::completed:
+                        complete();
+                        break;
+                    case add_result::stopped:
+                        stop_callback.reset();
+                        complete_stopped();
+                        break;
+                }
+            }
+
+            void complete_stopped() noexcept {
+                if constexpr (HandleT::consume) {
+                    handle->request_stop();
+                }
+
+                exec::set_stopped(std::move(receiver));
+            }
+
+            void complete() noexcept override {
+                stop_callback.reset();
+
+                std::visit([this]<typename TupleT>(TupleT& tuple) noexcept {
+                    if constexpr (!std::is_same_v<TupleT, std::monostate>) {
+                        std::apply([this]<typename TagT, typename... Ts>(TagT tag, Ts&... values) noexcept {
+                            if constexpr (HandleT::consume) {
+                                tag(std::move(receiver), std::move(values)...);
+                            }
+                            else {
+                                tag(std::move(receiver), std::as_const(values)...);
+                            }
+                        }, tuple);
+                    }
+                }, handle->m_result);
+            }
+        };
+
+        static constexpr auto get_completion_signatures =
+            []<typename SenderT, typename EnvT>(SenderT&&, EnvT&&) noexcept {
+                using handle_t = std::remove_cvref_t<data_of_t<SenderT>>;
+                using result_signatures_t = handle_t::state_t::result_signatures_t;
+
+                return typename elements_of<result_signatures_t>::template apply<
+                    signatures<handle_t>::template apply>{};
+            };
+
+        static constexpr auto get_state =
+            []<typename SenderT, typename ReceiverT>(SenderT&& sender, ReceiverT& receiver) noexcept {
+                using handle_t = std::remove_cvref_t<data_of_t<SenderT>>;
+
+                auto&& data = get_data(std::forward<SenderT>(sender));
+                return operation<handle_t, ReceiverT>{ std::forward_like<SenderT>(data), receiver };
+            };
+
+        static constexpr auto start =
+            []<typename StateT>(StateT& state, auto&) noexcept {
+                state.run();
+            };
+    };
+}
+
+#endif // !EXEC_DETAILS_SHARED_STATE_HPP
\ No newline at end of file
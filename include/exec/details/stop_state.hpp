@@ -2,20 +2,27 @@
 #define EXEC_DETAILS_STOP_STATE_HPP
 
 #include "exec/details/base_stop_callback.hpp"
-#include "exec/details/spin_lock_hint.hpp"
 
 #include <atomic>
 #include <cstdint>
 #include <thread>
+#include <utility>
 
 namespace exec::details {
+    // The head of the callback list and the state flags share one word. Adding a callback is a compare-exchange on
+    // it, as is requesting stop, which detaches the whole list. Only removal takes the Locked bit, to unlink a
+    // callback from the middle of the list while callbacks keep being pushed on top. Threads finding the word locked,
+    // or a callback being invoked, block on atomic wait instead of spinning.
     class stop_state {
     public:
-        enum state : uint8_t {
+        enum state : std::uintptr_t {
             Locked = 1,
             Closed = 1 << 1,
+            Flags = Locked | Closed,
         };
 
+        static_assert(alignof(base_stop_callback) > Flags);
+
         stop_state() noexcept = default;
 
         [[nodiscard]] bool stop_requested() const noexcept {
@@ -23,102 +30,140 @@ namespace exec::details {
         }
 
         [[nodiscard]] bool try_request_stop() noexcept {
-            const auto old = spin_lock();
+            std::uintptr_t expected = m_state.load(std::memory_order_relaxed);
+            for (;;) {
+                if ((expected & Closed) != 0) {
+                    return false;
+                }
 
-            if ((old & Closed) != 0) {
-                unlock(old);
-                return false;
+                if ((expected & Locked) != 0) {
+                    m_state.wait(expected, std::memory_order_relaxed);
+                    expected = m_state.load(std::memory_order_relaxed);
+                }
+                else if (m_state.compare_exchange_weak(expected,
+                                                       Closed,
+                                                       std::memory_order_acq_rel,
+                                                       std::memory_order_relaxed))
+                {
+                    break;
+                }
             }
 
-            m_callback_thread = std::this_thread::get_id();
+            m_callback_thread.store(std::this_thread::get_id(), std::memory_order_release);
 
-            auto* callback = m_head;
-            m_head = nullptr;
+            m_pending = head(expected);
+            while (m_pending != nullptr) {
+                std::exchange(m_pending, m_pending->prev)->pop();
 
-            unlock(old | Closed);
-
-            while (callback != nullptr) {
-                callback = callback->pop();
+                m_invocations.fetch_add(1, std::memory_order_release);
+                m_invocations.notify_all();
             }
 
             return true;
         }
 
         [[nodiscard]] bool try_add_callback(base_stop_callback* callback) const noexcept {
-            const auto old = spin_lock();
-
-            if ((old & Closed) != 0) {
-                unlock(old);
-                return false;
-            }
-
-            if (m_head != nullptr) {
-                m_head->next = callback;
-                callback->prev = m_head;
-            }
-
-            m_head = callback;
+            std::uintptr_t expected = m_state.load(std::memory_order_relaxed);
+            do {
+                if ((expected & Closed) != 0) {
+                    return false;
+                }
 
-            unlock(old);
+                callback->prev = head(expected);
+            } while (!m_state.compare_exchange_weak(expected,
+                                                    reinterpret_cast<std::uintptr_t>(callback) | (expected & Locked),
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed));
 
             return true;
         }
 
         void remove_callback(base_stop_callback* callback) const noexcept {
-            const auto old = spin_lock();
-
-            if ((old & Closed) != 0) {
-                const auto callback_thread = m_callback_thread;
-                unlock(old);
-
-                if (callback_thread == std::this_thread::get_id()) {
+            std::uintptr_t expected = m_state.load(std::memory_order_acquire);
+            for (;;) {
+                if ((expected & Closed) != 0) {
+                    wait_invoked(callback);
                     return;
                 }
 
-                while (!callback->invoked.load(std::memory_order_acquire)) {
-                    EXEC_SPIN_LOCK_HINT();
+                if ((expected & Locked) != 0) {
+                    m_state.wait(expected, std::memory_order_relaxed);
+                    expected = m_state.load(std::memory_order_acquire);
+                }
+                else if (m_state.compare_exchange_weak(expected,
+                                                       expected | Locked,
+                                                       std::memory_order_acquire,
+                                                       std::memory_order_acquire))
+                {
+                    break;
                 }
             }
-            else if (m_head == callback) {
-                m_head = callback->prev;
 
-                unlock(old);
-            }
-            else {
-                if (callback->next != nullptr) {
-                    callback->next->prev = callback->prev;
-                }
-                if (callback->prev != nullptr) {
-                    callback->prev->next = callback->next;
+            // Holding the lock, the links below the head are stable, new callbacks may still be pushed on top.
+            expected |= Locked;
+            while (head(expected) == callback) {
+                if (m_state.compare_exchange_weak(expected,
+                                                  reinterpret_cast<std::uintptr_t>(callback->prev) | Locked,
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_acquire))
+                {
+                    unlock();
+                    return;
                 }
+            }
 
-                unlock(old);
+            auto* above = head(expected);
+            while (above->prev != callback) {
+                above = above->prev;
             }
+
+            above->prev = callback->prev;
+            unlock();
         }
 
     private:
-        uint8_t spin_lock() const noexcept {
-            uint8_t expected = m_state.load(std::memory_order_relaxed);
-            do {
-                while ((expected & Locked) != 0) {
-                    EXEC_SPIN_LOCK_HINT();
-                    expected = m_state.load(std::memory_order_relaxed);
-                }
-            } while (!m_state.compare_exchange_weak(expected,
-                                                    expected | Locked,
-                                                    std::memory_order_acquire,
-                                                    std::memory_order_relaxed));
+        [[nodiscard]] static base_stop_callback* head(std::uintptr_t state) noexcept {
+            return reinterpret_cast<base_stop_callback*>(state & ~std::uintptr_t{ Flags });
+        }
 
-            return expected;
+        void unlock() const noexcept {
+            m_state.fetch_and(~std::uintptr_t{ Locked }, std::memory_order_release);
+            m_state.notify_all();
         }
 
-        void unlock(uint8_t state) const noexcept {
-            m_state.store(state & ~Locked, std::memory_order_release);
+        // A callback found in a closed state is either being invoked or about to be. Only the thread requesting stop
+        // can remove one that is still pending, from within another callback, it is then unlinked and never invoked.
+        // Other threads wait on the invocation count of the state rather than on the callback, which may be destroyed
+        // as soon as its invoked flag is set, while the state outlives the call to try_request_stop().
+        void wait_invoked(base_stop_callback* callback) const noexcept {
+            if (m_callback_thread.load(std::memory_order_acquire) != std::this_thread::get_id()) {
+                for (;;) {
+                    const std::uint32_t invocations = m_invocations.load(std::memory_order_acquire);
+                    if (callback->invoked.load(std::memory_order_acquire)) {
+                        return;
+                    }
+
+                    m_invocations.wait(invocations, std::memory_order_acquire);
+                }
+            }
+
+            if (m_pending == callback) {
+                m_pending = callback->prev;
+                return;
+            }
+
+            for (auto* above = m_pending; above != nullptr; above = above->prev) {
+                if (above->prev == callback) {
+                    above->prev = callback->prev;
+                    return;
+                }
+            }
         }
 
-        mutable std::atomic_uint8_t m_state{ 0 };
-        mutable base_stop_callback* m_head{ nullptr };
-        std::thread::id m_callback_thread{};
+        mutable std::atomic_uintptr_t m_state{ 0 };
+        std::atomic<std::thread::id> m_callback_thread{};
+        std::atomic_uint32_t m_invocations{ 0 };
+        mutable base_stop_callback* m_pending{ nullptr };
 
     };
 }
@@ -0,0 +1,49 @@
+#ifndef EXEC_DETAILS_STOP_TOKEN_BRIDGE_HPP
+#define EXEC_DETAILS_STOP_TOKEN_BRIDGE_HPP
+
+#include "exec/stop_token.hpp"
+
+#include <optional>
+#include <type_traits>
+
+namespace exec::details {
+    // Presents any stop token as an inplace_stop_token. Inplace and unstoppable tokens are passed through, others are
+    // forwarded to an owned inplace_stop_source for as long as the bridge is attached.
+    template<typename StopTokenT>
+    class stop_token_bridge {
+        struct on_stop {
+            inplace_stop_source& source;
+
+            void operator()() const noexcept {
+                source.request_stop();
+            }
+        };
+
+        using stop_callback_t = typename StopTokenT::template callback_type<on_stop>;
+
+    public:
+        [[nodiscard]] inplace_stop_token attach(const StopTokenT& token) noexcept {
+            if constexpr (std::is_same_v<StopTokenT, inplace_stop_token>) {
+                return token;
+            }
+            else if constexpr (unstoppable_token<StopTokenT>) {
+                return {};
+            }
+            else {
+                m_callback.emplace(token, on_stop{ m_source });
+                return m_source.get_token();
+            }
+        }
+
+        void detach() noexcept {
+            m_callback.reset();
+        }
+
+    private:
+        inplace_stop_source m_source{};
+        std::optional<stop_callback_t> m_callback{};
+
+    };
+}
+
+#endif // !EXEC_DETAILS_STOP_TOKEN_BRIDGE_HPP
\ No newline at end of file
@@ -0,0 +1,185 @@
+#ifndef EXEC_DETAILS_SYNC_WAIT_LOOP_HPP
+#define EXEC_DETAILS_SYNC_WAIT_LOOP_HPP
+
+#include "exec/completions.hpp"
+#include "exec/completion_signatures.hpp"
+#include "exec/env.hpp"
+#include "exec/operation_state.hpp"
+#include "exec/receiver.hpp"
+#include "exec/scheduler.hpp"
+#include "exec/sender.hpp"
+#include "exec/stop_token.hpp"
+
+#include "exec/details/atomic_intrusive_queue.hpp"
+#include "exec/details/intrusive_task.hpp"
+#include "exec/details/spin_lock_hint.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace exec::details {
+    // The loop a sync_wait caller blocks in. Everything goes through one atomic word waited on with atomic wait: the
+    // completion sets its Finished bit, work scheduled onto the loop bumps its counter after a lock-free push. A sender
+    // completing inline costs no wait at all and one completing on another thread a single wait and notify, the queue
+    // is only touched when something is actually scheduled onto get_scheduler().
+    class sync_wait_loop {
+        template<receiver ReceiverT>
+        struct operation_state : intrusive_task {
+            using operation_state_concept = operation_state_t;
+
+            explicit operation_state(sync_wait_loop* loop, receiver auto&& receiver) noexcept :
+                intrusive_task(&operation_state::execute),
+                loop(loop),
+                receiver(std::forward<decltype(receiver)>(receiver)) {}
+
+            sync_wait_loop* loop;
+            ReceiverT receiver;
+
+            static void execute(intrusive_task* task) noexcept {
+                auto& self = *static_cast<operation_state*>(task);
+
+                if (get_stop_token(exec::get_env(self.receiver)).stop_requested()) {
+                    set_stopped(std::move(self.receiver));
+                }
+                else {
+                    set_value(std::move(self.receiver));
+                }
+            }
+
+            void start() noexcept {
+                loop->push(this);
+            }
+        };
+
+        // The low half holds the flags and the count of push() calls in flight, the high half the count of pushes.
+        enum signal : std::uint32_t {
+            Finished = 1,
+            Released = 1 << 1,
+            Pusher = 1 << 2,
+            Pushers = 0xFFFC,
+            Pushed = 1 << 16
+        };
+
+        static constexpr std::uint32_t release_spin = 64;
+
+    public:
+        struct scheduler {
+            struct sender {
+                struct env {
+                    sync_wait_loop* loop;
+
+                    [[nodiscard]] constexpr auto query(get_completion_scheduler_t<set_value_t>) const noexcept {
+                        return loop->get_scheduler();
+                    }
+
+                    [[nodiscard]] constexpr auto query(get_completion_scheduler_t<set_stopped_t>) const noexcept {
+                        return loop->get_scheduler();
+                    }
+                };
+
+                using sender_concept = sender_t;
+
+                using completion_signatures = exec::completion_signatures<set_value_t(), set_stopped_t()>;
+
+                sync_wait_loop* loop;
+
+                [[nodiscard]] auto get_env() const noexcept {
+                    return env{ loop };
+                }
+
+                constexpr auto connect(receiver auto&& rcvr) noexcept {
+                    return operation_state<std::decay_t<decltype(rcvr)>>(loop, std::forward<decltype(rcvr)>(rcvr));
+                }
+            };
+
+            using scheduler_concept = scheduler_t;
+
+            sync_wait_loop* loop;
+
+            [[nodiscard]] constexpr sender schedule() const noexcept {
+                return sender{ loop };
+            }
+
+        private:
+            [[nodiscard]]
+            friend constexpr bool operator==(const scheduler& left, const scheduler& right) noexcept {
+                return left.loop == right.loop;
+            }
+
+        };
+
+        sync_wait_loop() noexcept = default;
+
+        sync_wait_loop(sync_wait_loop&&) = delete;
+
+        constexpr scheduler get_scheduler() noexcept {
+            return scheduler{ this };
+        }
+
+        // Runs scheduled work until finish() has been called and the queue is empty. The word is read before the
+        // queue, so a push or a finish landing after the read changes it and the wait returns at once.
+        void run() noexcept {
+            for (;;) {
+                const std::uint32_t observed = m_signal.load(std::memory_order_acquire);
+
+                auto tasks = m_queue.pop_all();
+                if (tasks.empty()) {
+                    if ((observed & Finished) != 0) {
+                        wait_released(observed);
+                        return;
+                    }
+
+                    m_signal.wait(observed, std::memory_order_acquire);
+                    continue;
+                }
+
+                while (auto* task = tasks.pop_front()) {
+                    task->execute();
+                }
+            }
+        }
+
+        // Released is only set once notify_one() has returned, run() waits for it so that the loop is not destroyed
+        // under a notification still in flight.
+        void finish() noexcept {
+            m_signal.fetch_or(Finished, std::memory_order_release);
+            m_signal.notify_one();
+            m_signal.fetch_or(Released, std::memory_order_release);
+        }
+
+    private:
+        // Once a task is in the queue, run() can execute it and the sync_wait complete before the thread that pushed
+        // it has signalled, so run() also waits for every push() in flight to be done with the loop. The window is a
+        // notify_one() long, past a short spin the signalling thread has likely been preempted and the caller yields.
+        void wait_released(std::uint32_t observed) const noexcept {
+            for (std::uint32_t spin = 0; (observed & Released) == 0 || (observed & Pushers) != 0; ++spin) {
+                if (spin < release_spin) {
+                    EXEC_SPIN_LOCK_HINT();
+                }
+                else {
+                    std::this_thread::yield();
+                }
+
+                observed = m_signal.load(std::memory_order_acquire);
+            }
+        }
+
+        void push(intrusive_task* task) noexcept {
+            m_signal.fetch_add(Pusher, std::memory_order_relaxed);
+            m_queue.push(task);
+
+            m_signal.fetch_add(Pushed, std::memory_order_release);
+            m_signal.notify_one();
+            m_signal.fetch_sub(Pusher, std::memory_order_release);
+        }
+
+        atomic_intrusive_queue<intrusive_task> m_queue;
+        std::atomic_uint32_t m_signal{ 0 };
+
+    };
+}
+
+#endif // !EXEC_DETAILS_SYNC_WAIT_LOOP_HPP
\ No newline at end of file
@@ -1,12 +1,12 @@
 #ifndef EXEC_DETAILS_SYNC_WAIT_STATE_HPP
 #define EXEC_DETAILS_SYNC_WAIT_STATE_HPP
 
-#include "exec/run_loop.hpp"
 #include "exec/scheduler.hpp"
 #include "exec/transform_completion_signatures.hpp"
 
 #include "exec/details/decayed_tuple.hpp"
 #include "exec/details/meta_merge.hpp"
+#include "exec/details/sync_wait_loop.hpp"
 
 #include <exception>
 #include <optional>
@@ -15,8 +15,11 @@
 #include <variant>
 
 namespace exec::details {
+    template<typename... Ts>
+    using decayed_variant = std::variant<std::decay_t<Ts>...>;
+
     template<typename SenderT, typename EnvT = empty_env>
-    using sync_wait_error_type = std::optional<meta_merge_t<std::variant<std::exception_ptr>, error_types_of_t<SenderT, EnvT, std::variant>>>;
+    using sync_wait_error_type = std::optional<meta_merge_t<std::variant<std::exception_ptr>, error_types_of_t<SenderT, EnvT, decayed_variant>>>;
 
     template<typename SenderT, typename EnvT = empty_env>
     using sync_wait_result_type = std::optional<value_types_of_t<SenderT, EnvT, decayed_tuple, std::type_identity_t>>;
@@ -33,16 +36,20 @@ namespace exec::details {
     inline constexpr sync_wait_error_handler_t sync_wait_error_handler{};
 
     struct sync_wait_env {
-        run_loop* loop;
+        sync_wait_loop* loop;
 
         [[nodiscard]] constexpr decltype(auto) query(get_scheduler_t) const noexcept {
             return loop->get_scheduler();
         }
+
+        [[nodiscard]] constexpr decltype(auto) query(get_delegation_scheduler_t) const noexcept {
+            return loop->get_scheduler();
+        }
     };
 
     template<typename SenderT>
     struct sync_wait_state {
-        run_loop loop;
+        sync_wait_loop loop;
         sync_wait_error_type<SenderT, sync_wait_env> error;
         sync_wait_result_type<SenderT, sync_wait_env> result;
     };
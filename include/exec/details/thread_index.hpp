@@ -0,0 +1,17 @@
+#ifndef EXEC_DETAILS_THREAD_INDEX_HPP
+#define EXEC_DETAILS_THREAD_INDEX_HPP
+
+#include <atomic>
+#include <cstddef>
+
+namespace exec::details {
+    // Small dense index of the calling thread, assigned on first use and never reused.
+    [[nodiscard]] inline std::size_t thread_index() noexcept {
+        static constinit std::atomic_size_t next{ 0 };
+        static thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+
+        return index;
+    }
+}
+
+#endif // !EXEC_DETAILS_THREAD_INDEX_HPP
\ No newline at end of file
@@ -0,0 +1,309 @@
+#ifndef EXEC_DETAILS_TIMER_WHEEL_HPP
+#define EXEC_DETAILS_TIMER_WHEEL_HPP
+
+#include "exec/details/intrusive_queue.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace exec::details {
+    struct timer_node {
+        timer_node* next{ nullptr };
+        timer_node* prev{ nullptr };
+        std::uint64_t deadline{ 0 };
+        std::uint32_t slot{ 0 };
+        bool linked{ false };
+    };
+
+    // Hierarchical timing wheel with 4 levels of 256 slots. Level L holds the timers whose deadline shares every
+    // bit above 8 * (L + 1) with the current tick, so a timer is placed and unlinked in O(1), and only moves down
+    // a level when the wheel reaches the start of its slot. Timers beyond the highest level wait in an overflow
+    // list which is redistributed every 2^32 ticks. Ticks are abstract, the owner decides their resolution.
+    //
+    // Not synchronized, the owner is expected to guard it.
+    class timer_wheel {
+        static constexpr std::size_t level_bits = 8;
+        static constexpr std::size_t slot_count = std::size_t{ 1 } << level_bits;
+        static constexpr std::size_t level_count = 4;
+        static constexpr std::uint64_t slot_mask = slot_count - 1;
+
+        static constexpr std::uint32_t overflow_slot = level_count * slot_count;
+        static constexpr std::uint32_t due_slot = overflow_slot + 1;
+
+        struct level {
+            std::array<std::uint64_t, slot_count / 64> occupied{};
+            std::array<timer_node*, slot_count> slots{};
+        };
+
+    public:
+        static constexpr std::uint64_t never = std::numeric_limits<std::uint64_t>::max();
+
+        explicit timer_wheel(std::uint64_t now = 0) noexcept : m_current(now) {}
+
+        timer_wheel(timer_wheel&&) = delete;
+
+        [[nodiscard]] bool empty() const noexcept {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept {
+            return m_size;
+        }
+
+        [[nodiscard]] std::uint64_t current() const noexcept {
+            return m_current;
+        }
+
+        void insert(timer_node* node) noexcept {
+            ++m_size;
+
+            if (node->deadline <= m_current) {
+                link(m_due, node, due_slot);
+            }
+            else {
+                place(node);
+            }
+        }
+
+        void remove(timer_node* node) noexcept {
+            if (!node->linked) {
+                return;
+            }
+
+            --m_size;
+            unlink(node);
+        }
+
+        // Moves every timer whose deadline is not after `now` into `expired`.
+        void advance(std::uint64_t now, intrusive_queue<timer_node>& expired) noexcept {
+            expire(m_due, due_slot, expired);
+
+            while (m_current < now) {
+                const std::uint64_t tick = next_event();
+                if (tick > now) {
+                    m_current = now;
+                    break;
+                }
+
+                m_current = tick;
+
+                if ((m_current & low_mask(level_count)) == 0) {
+                    cascade(m_overflow, overflow_slot, expired);
+                }
+
+                for (std::size_t index = level_count - 1; index > 0; --index) {
+                    if ((m_current & low_mask(index)) == 0) {
+                        const auto slot = slot_index(m_current, index);
+                        cascade(m_levels[index].slots[slot], id_of(index, slot), expired);
+                    }
+                }
+
+                const auto slot = slot_index(m_current, 0);
+                expire(m_levels[0].slots[slot], id_of(0, slot), expired);
+            }
+        }
+
+        // Tick at which `advance` has something to do next, either firing or cascading timers, or `never`.
+        [[nodiscard]] std::uint64_t next_tick() const noexcept {
+            if (m_due != nullptr) {
+                return m_current;
+            }
+
+            return next_event();
+        }
+
+        // Unlinks every pending timer, used when the owner shuts down.
+        void take_all(intrusive_queue<timer_node>& out) noexcept {
+            expire(m_due, due_slot, out);
+            expire(m_overflow, overflow_slot, out);
+
+            for (std::size_t index = 0; index < level_count; ++index) {
+                for (std::size_t slot = 0; slot < slot_count; ++slot) {
+                    expire(m_levels[index].slots[slot], id_of(index, slot), out);
+                }
+            }
+        }
+
+    private:
+        [[nodiscard]] static constexpr std::uint64_t low_mask(std::size_t index) noexcept {
+            return (std::uint64_t{ 1 } << (level_bits * index)) - 1;
+        }
+
+        [[nodiscard]] static constexpr std::size_t slot_index(std::uint64_t tick, std::size_t index) noexcept {
+            return static_cast<std::size_t>((tick >> (level_bits * index)) & slot_mask);
+        }
+
+        [[nodiscard]] static constexpr std::uint32_t id_of(std::size_t index, std::size_t slot) noexcept {
+            return static_cast<std::uint32_t>(index * slot_count + slot);
+        }
+
+        void place(timer_node* node) noexcept {
+            const std::uint64_t deadline = node->deadline;
+
+            for (std::size_t index = 0; index < level_count; ++index) {
+                const std::size_t shift = level_bits * (index + 1);
+                if ((deadline >> shift) == (m_current >> shift)) {
+                    const auto slot = slot_index(deadline, index);
+                    link(m_levels[index].slots[slot], node, id_of(index, slot));
+                    m_levels[index].occupied[slot / 64] |= std::uint64_t{ 1 } << (slot % 64);
+                    return;
+                }
+            }
+
+            link(m_overflow, node, overflow_slot);
+        }
+
+        void cascade(timer_node*& head, std::uint32_t id, intrusive_queue<timer_node>& expired) noexcept {
+            auto* node = detach(head, id);
+
+            while (node != nullptr) {
+                auto* const next = node->next;
+
+                if (node->deadline <= m_current) {
+                    node->linked = false;
+                    --m_size;
+                    expired.push_back(node);
+                }
+                else {
+                    place(node);
+                }
+
+                node = next;
+            }
+        }
+
+        void expire(timer_node*& head, std::uint32_t id, intrusive_queue<timer_node>& expired) noexcept {
+            auto* node = detach(head, id);
+
+            while (node != nullptr) {
+                auto* const next = node->next;
+
+                node->linked = false;
+                --m_size;
+                expired.push_back(node);
+
+                node = next;
+            }
+        }
+
+        [[nodiscard]] timer_node* detach(timer_node*& head, std::uint32_t id) noexcept {
+            auto* const node = head;
+            head = nullptr;
+
+            if (id < overflow_slot) {
+                clear_bit(id);
+            }
+
+            return node;
+        }
+
+        [[nodiscard]] std::uint64_t next_event() const noexcept {
+            std::uint64_t result = never;
+
+            for (std::size_t index = 0; index < level_count; ++index) {
+                const std::size_t slot = find_after(index, slot_index(m_current, index));
+                if (slot < slot_count) {
+                    const std::size_t shift = level_bits * (index + 1);
+                    const std::uint64_t tick = ((m_current >> shift) << shift) |
+                                               (static_cast<std::uint64_t>(slot) << (level_bits * index));
+                    result = std::min(result, tick);
+                }
+            }
+
+            if (m_overflow != nullptr) {
+                const std::size_t shift = level_bits * level_count;
+                result = std::min(result, ((m_current >> shift) + 1) << shift);
+            }
+
+            return result;
+        }
+
+        // First occupied slot of the level strictly after `slot`, or slot_count.
+        [[nodiscard]] std::size_t find_after(std::size_t index, std::size_t slot) const noexcept {
+            const auto& occupied = m_levels[index].occupied;
+
+            std::size_t word = (slot + 1) / 64;
+            if (word >= occupied.size()) {
+                return slot_count;
+            }
+
+            std::uint64_t bits = occupied[word] & (~std::uint64_t{ 0 } << ((slot + 1) % 64));
+            while (bits == 0) {
+                if (++word == occupied.size()) {
+                    return slot_count;
+                }
+
+                bits = occupied[word];
+            }
+
+            return word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+        }
+
+        void link(timer_node*& head, timer_node* node, std::uint32_t id) noexcept {
+            node->prev = nullptr;
+            node->next = head;
+            node->slot = id;
+            node->linked = true;
+
+            if (head != nullptr) {
+                head->prev = node;
+            }
+
+            head = node;
+        }
+
+        void unlink(timer_node* node) noexcept {
+            auto*& head = head_of(node->slot);
+
+            if (node->prev != nullptr) {
+                node->prev->next = node->next;
+            }
+            else {
+                head = node->next;
+            }
+
+            if (node->next != nullptr) {
+                node->next->prev = node->prev;
+            }
+
+            if (head == nullptr && node->slot < overflow_slot) {
+                clear_bit(node->slot);
+            }
+
+            node->next = nullptr;
+            node->prev = nullptr;
+            node->linked = false;
+        }
+
+        [[nodiscard]] timer_node*& head_of(std::uint32_t id) noexcept {
+            if (id == due_slot) {
+                return m_due;
+            }
+
+            if (id == overflow_slot) {
+                return m_overflow;
+            }
+
+            return m_levels[id / slot_count].slots[id % slot_count];
+        }
+
+        void clear_bit(std::uint32_t id) noexcept {
+            const std::size_t slot = id % slot_count;
+            m_levels[id / slot_count].occupied[slot / 64] &= ~(std::uint64_t{ 1 } << (slot % 64));
+        }
+
+        std::uint64_t m_current;
+        std::size_t m_size{ 0 };
+
+        std::array<level, level_count> m_levels{};
+        timer_node* m_overflow{ nullptr };
+        timer_node* m_due{ nullptr };
+
+    };
+}
+
+#endif // !EXEC_DETAILS_TIMER_WHEEL_HPP
\ No newline at end of file
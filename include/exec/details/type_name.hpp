@@ -0,0 +1,46 @@
+#ifndef EXEC_DETAILS_TYPE_NAME_HPP
+#define EXEC_DETAILS_TYPE_NAME_HPP
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace exec::details {
+    template<typename T>
+    [[nodiscard]] consteval std::string_view pretty_type_name() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+        constexpr std::string_view signature = __FUNCSIG__;
+        constexpr std::string_view prefix = "pretty_type_name<";
+        constexpr std::string_view suffix = ">(void) noexcept";
+
+        const std::size_t begin = signature.find(prefix) + prefix.size();
+        const std::size_t end = signature.rfind(suffix);
+#else
+        constexpr std::string_view signature = __PRETTY_FUNCTION__;
+        constexpr std::string_view prefix = "T = ";
+
+        const std::size_t begin = signature.find(prefix) + prefix.size();
+        const std::size_t end = signature.find_first_of(";]", begin);
+#endif
+
+        return signature.substr(begin, end - begin);
+    }
+
+    // The name is copied out of the function signature, so that it is a constant with static storage of its own.
+    template<typename T>
+    struct type_name_storage {
+        static constexpr std::string_view name = pretty_type_name<T>();
+
+        static constexpr auto value = [] {
+            std::array<char, name.size()> chars{};
+            name.copy(chars.data(), chars.size());
+            return chars;
+        }();
+    };
+
+    template<typename T>
+    inline constexpr std::string_view type_name{ type_name_storage<T>::value.data(),
+                                                 type_name_storage<T>::value.size() };
+}
+
+#endif // !EXEC_DETAILS_TYPE_NAME_HPP
\ No newline at end of file
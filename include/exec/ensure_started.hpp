@@ -0,0 +1,72 @@
+#ifndef EXEC_ENSURE_STARTED_HPP
+#define EXEC_ENSURE_STARTED_HPP
+
+#include "exec/completion_signatures.hpp"
+#include "exec/sender.hpp"
+#include "exec/sender_adapter_closure.hpp"
+
+#include "exec/details/basic_closure.hpp"
+#include "exec/details/basic_sender.hpp"
+#include "exec/details/product_type.hpp"
+#include "exec/details/shared_state.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace exec {
+    struct ensure_started_t;
+
+    namespace details {
+        // Sole owner of an eagerly started shared_state. Dropping it before it was connected detaches the work and
+        // asks it to stop, once connected that is up to the consumer's stop token.
+        template<typename SenderT>
+        class eager_handle : public shared_handle<SenderT> {
+        public:
+            static constexpr bool consume = true;
+
+            template<typename TagT, typename... ArgTs>
+            using signature_t = completion_signatures<TagT(ArgTs&&...)>;
+
+            using shared_handle<SenderT>::shared_handle;
+
+            eager_handle(const eager_handle&) = delete;
+
+            eager_handle(eager_handle&&) noexcept = default;
+
+            ~eager_handle() {
+                if (auto* const state = this->operator->(); state != nullptr && !m_connected) {
+                    state->request_stop();
+                }
+            }
+
+            void connected() noexcept {
+                m_connected = true;
+            }
+
+        private:
+            bool m_connected{ false };
+        };
+    }
+
+    template<>
+    struct details::impls_for<ensure_started_t> : shared_impls {};
+
+    struct ensure_started_t {
+        template<sender SenderT>
+        [[nodiscard]] auto operator()(SenderT&& input) const {
+            using state_t = details::shared_state<std::decay_t<SenderT>>;
+
+            details::eager_handle<std::decay_t<SenderT>> handle{ new state_t(std::forward<SenderT>(input)) };
+            handle->start();
+
+            return details::make_sender(*this, std::move(handle));
+        }
+
+        [[nodiscard]] constexpr auto operator()() const noexcept {
+            return details::basic_closure{ sender_adapter_closure<ensure_started_t>{}, details::product_type{} };
+        }
+    };
+    inline constexpr ensure_started_t ensure_started{};
+}
+
+#endif // !EXEC_ENSURE_STARTED_HPP
\ No newline at end of file
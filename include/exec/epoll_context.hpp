@@ -0,0 +1,964 @@
+#ifndef EXEC_EPOLL_CONTEXT_HPP
+#define EXEC_EPOLL_CONTEXT_HPP
+
+#if defined(__linux__)
+
+#include "exec/completions.hpp"
+#include "exec/completion_signatures.hpp"
+#include "exec/env.hpp"
+#include "exec/io.hpp"
+#include "exec/operation_state.hpp"
+#include "exec/receiver.hpp"
+#include "exec/scheduler.hpp"
+#include "exec/sender.hpp"
+#include "exec/stop_token.hpp"
+#include "exec/timed_scheduler.hpp"
+
+#include "exec/details/atomic_intrusive_queue.hpp"
+#include "exec/details/intrusive_queue.hpp"
+#include "exec/details/intrusive_task.hpp"
+#include "exec/details/timer_wheel.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace exec {
+    // Reactor multiplexing epoll readiness and timers with a task queue on the thread calling run(). I/O and timer
+    // completions are delivered inline on that thread. File descriptors passed to the readiness based senders must
+    // be non-blocking. Regular files are always ready, so positional reads and writes (a negative offset uses the file
+    // position) and fsync on them are performed directly on the reactor thread.
+    class epoll_context {
+    public:
+        using clock = std::chrono::steady_clock;
+        using time_point = clock::time_point;
+        using duration = clock::duration;
+
+        using tick_duration = std::chrono::milliseconds;
+
+    private:
+        struct op_base : details::intrusive_task {
+            enum class op_state : std::uint8_t {
+                pending,
+                registered,
+                cancelled,
+                deferred
+            };
+
+            // Delivers the stored result, unless a stop request is still in flight.
+            using complete_fn = void(op_base*) noexcept;
+
+            explicit op_base(execute_fn* execute, complete_fn* complete, epoll_context* context) noexcept :
+                intrusive_task(execute),
+                complete(complete),
+                context(context) {}
+
+            complete_fn* complete;
+            epoll_context* context;
+
+            op_state state{ op_state::pending };
+            std::atomic_bool cancel_posted{ false };
+            bool stopped{ false };
+        };
+
+        struct io_base : op_base {
+            // Attempts the syscall, returns false if it would block.
+            using perform_fn = bool(io_base*) noexcept;
+
+            explicit io_base(execute_fn* execute, complete_fn* complete, epoll_context* context,
+                             perform_fn* perform, int fd, bool writing) noexcept :
+                op_base(execute, complete, context),
+                perform(perform),
+                fd(fd),
+                writing(writing) {}
+
+            perform_fn* perform;
+            int fd;
+            bool writing;
+
+            io_base* prev_waiter{ nullptr };
+            io_base* next_waiter{ nullptr };
+
+            std::int64_t result{ 0 };
+            int error{ 0 };
+        };
+
+        struct timer_base : op_base, details::timer_node {
+            using op_base::op_base;
+        };
+
+        struct waiter_list {
+            io_base* head{ nullptr };
+            io_base* tail{ nullptr };
+        };
+
+        struct fd_state {
+            waiter_list readers;
+            waiter_list writers;
+            std::uint32_t events{ 0 };
+        };
+
+        struct read_some_io {
+            using completion_signature = set_value_t(std::size_t);
+
+            static constexpr bool writing = false;
+
+            std::span<std::byte> buffer;
+
+            [[nodiscard]] std::int64_t operator()(int fd) const noexcept {
+                return ::read(fd, buffer.data(), buffer.size());
+            }
+        };
+
+        struct write_some_io {
+            using completion_signature = set_value_t(std::size_t);
+
+            static constexpr bool writing = true;
+
+            std::span<const std::byte> buffer;
+
+            [[nodiscard]] std::int64_t operator()(int fd) const noexcept {
+                return ::write(fd, buffer.data(), buffer.size());
+            }
+        };
+
+        struct read_io {
+            using completion_signature = set_value_t(std::size_t);
+
+            static constexpr bool writing = false;
+
+            std::span<std::byte> buffer;
+            std::int64_t offset;
+
+            [[nodiscard]] std::int64_t operator()(int fd) const noexcept {
+                if (offset < 0) {
+                    return ::read(fd, buffer.data(), buffer.size());
+                }
+
+                return ::pread(fd, buffer.data(), buffer.size(), static_cast<::off_t>(offset));
+            }
+        };
+
+        struct write_io {
+            using completion_signature = set_value_t(std::size_t);
+
+            static constexpr bool writing = true;
+
+            std::span<const std::byte> buffer;
+            std::int64_t offset;
+
+            [[nodiscard]] std::int64_t operator()(int fd) const noexcept {
+                if (offset < 0) {
+                    return ::write(fd, buffer.data(), buffer.size());
+                }
+
+                return ::pwrite(fd, buffer.data(), buffer.size(), static_cast<::off_t>(offset));
+            }
+        };
+
+        struct fsync_io {
+            using completion_signature = set_value_t();
+
+            static constexpr bool writing = true;
+
+            [[nodiscard]] std::int64_t operator()(int fd) const noexcept {
+                return ::fsync(fd);
+            }
+        };
+
+        struct accept_io {
+            using completion_signature = set_value_t(int);
+
+            static constexpr bool writing = false;
+
+            [[nodiscard]] std::int64_t operator()(int fd) const noexcept {
+                return ::accept4(fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            }
+        };
+
+        template<receiver ReceiverT>
+        struct operation_state : details::intrusive_task {
+            using operation_state_concept = operation_state_t;
+
+            explicit operation_state(epoll_context* context, receiver auto&& receiver) noexcept :
+                intrusive_task(&operation_state::execute),
+                context(context),
+                receiver(std::forward<decltype(receiver)>(receiver)) {}
+
+            epoll_context* context;
+            ReceiverT receiver;
+
+            static void execute(intrusive_task* task) noexcept {
+                auto& self = *static_cast<operation_state*>(task);
+
+                if (get_stop_token(exec::get_env(self.receiver)).stop_requested()) {
+                    set_stopped(std::move(self.receiver));
+                }
+                else {
+                    set_value(std::move(self.receiver));
+                }
+            }
+
+            void start() noexcept {
+                try {
+                    context->push_back(this);
+                }
+                catch (...) {
+                    set_error(std::move(receiver), std::current_exception());
+                }
+            }
+        };
+
+        // Stop handling shared by I/O and timers. A stop request posts a cancel task to the reactor, DerivedT provides
+        // begin(), unregister() and deliver() which only ever run on the reactor thread.
+        template<typename DerivedT, typename BaseT, typename ReceiverT>
+        struct reactor_operation : BaseT {
+            struct cancel_task : details::intrusive_task {
+                explicit cancel_task(reactor_operation* self) noexcept :
+                    intrusive_task(&reactor_operation::cancel),
+                    self(self) {}
+
+                reactor_operation* self;
+            };
+
+            struct on_stop {
+                reactor_operation* self;
+
+                void operator()() const noexcept {
+                    self->cancel_posted.store(true, std::memory_order_release);
+                    self->context->post(&self->cancel_node);
+                }
+            };
+
+            using operation_state_concept = operation_state_t;
+
+            using stop_token_t = stop_token_of_t<env_of_t<ReceiverT>>;
+            using stop_callback_t = typename stop_token_t::template callback_type<on_stop>;
+
+            template<typename... ArgTs>
+            explicit reactor_operation(epoll_context* context, ReceiverT&& receiver, ArgTs&&... args) noexcept :
+                BaseT(&reactor_operation::begin_op, &reactor_operation::complete_op, context,
+                      std::forward<ArgTs>(args)...),
+                receiver(std::move(receiver)) {}
+
+            ReceiverT receiver;
+            std::optional<stop_callback_t> stop_callback{};
+            cancel_task cancel_node{ this };
+
+            void start() noexcept {
+                auto token = get_stop_token(exec::get_env(receiver));
+                if (token.stop_requested()) {
+                    set_stopped(std::move(receiver));
+                    return;
+                }
+
+                // Registered until the operation is posted, run() cannot return in between.
+                const push_scope scope(this->context);
+
+                try {
+                    this->context->ensure_running();
+                }
+                catch (...) {
+                    set_error(std::move(receiver), std::current_exception());
+                    return;
+                }
+
+                stop_callback.emplace(token, on_stop{ this });
+
+                if (this->context->on_reactor_thread()) {
+                    begin_op(this);
+                }
+                else {
+                    this->context->post(this);
+                }
+            }
+
+            static void begin_op(details::intrusive_task* task) noexcept {
+                auto& self = *static_cast<reactor_operation*>(static_cast<BaseT*>(task));
+
+                if (self.state == BaseT::op_state::cancelled) {
+                    self.stop_callback.reset();
+                    set_stopped(std::move(self.receiver));
+                    return;
+                }
+
+                static_cast<DerivedT&>(self).begin();
+            }
+
+            static void complete_op(op_base* base) noexcept {
+                auto& self = *static_cast<reactor_operation*>(static_cast<BaseT*>(base));
+
+                // Once the callback is gone it can't fire anymore. If it already did, the cancel task is queued and
+                // the completion has to wait for it, otherwise the task would run on a destroyed operation.
+                self.stop_callback.reset();
+                if (self.cancel_posted.load(std::memory_order_acquire)) {
+                    self.state = BaseT::op_state::deferred;
+                    return;
+                }
+
+                static_cast<DerivedT&>(self).deliver();
+            }
+
+            static void cancel(details::intrusive_task* task) noexcept {
+                auto& self = *static_cast<cancel_task*>(task)->self;
+
+                switch (self.state) {
+                    case BaseT::op_state::pending:
+                        self.state = BaseT::op_state::cancelled;
+                        break;
+                    case BaseT::op_state::registered:
+                        static_cast<DerivedT&>(self).unregister();
+                        self.stop_callback.reset();
+                        set_stopped(std::move(self.receiver));
+                        break;
+                    case BaseT::op_state::deferred:
+                        static_cast<DerivedT&>(self).deliver();
+                        break;
+                    case BaseT::op_state::cancelled:
+                        break;
+                }
+            }
+        };
+
+        template<receiver ReceiverT, typename IoT>
+        struct io_operation_state : reactor_operation<io_operation_state<ReceiverT, IoT>, io_base, ReceiverT> {
+            using base_t = reactor_operation<io_operation_state, io_base, ReceiverT>;
+
+            explicit io_operation_state(epoll_context* context, int fd, IoT io, ReceiverT receiver) noexcept :
+                base_t(context, std::move(receiver), &io_operation_state::perform_io, fd, IoT::writing),
+                io(io) {}
+
+            IoT io;
+
+            void begin() noexcept {
+                if (perform_io(this)) {
+                    this->complete(this);
+                    return;
+                }
+
+                if (const auto ec = this->context->add_waiter(this)) {
+                    this->error = ec.value();
+                    this->complete(this);
+                    return;
+                }
+
+                this->state = io_base::op_state::registered;
+            }
+
+            void unregister() noexcept {
+                this->context->remove_waiter(this);
+            }
+
+            static bool perform_io(io_base* base) noexcept {
+                auto& self = *static_cast<io_operation_state*>(base);
+
+                while (true) {
+                    const std::int64_t result = self.io(self.fd);
+                    if (result >= 0) {
+                        self.result = result;
+                        return true;
+                    }
+
+                    if (errno == EINTR) {
+                        continue;
+                    }
+
+                    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                        return false;
+                    }
+
+                    self.error = errno;
+                    return true;
+                }
+            }
+
+            void deliver() noexcept {
+                if (this->stopped) {
+                    set_stopped(std::move(this->receiver));
+                }
+                else if (this->error != 0) {
+                    set_error(std::move(this->receiver), std::error_code(this->error, std::system_category()));
+                }
+                else if constexpr (std::is_same_v<typename IoT::completion_signature, set_value_t()>) {
+                    set_value(std::move(this->receiver));
+                }
+                else if constexpr (std::is_same_v<typename IoT::completion_signature, set_value_t(int)>) {
+                    set_value(std::move(this->receiver), static_cast<int>(this->result));
+                }
+                else {
+                    set_value(std::move(this->receiver), static_cast<std::size_t>(this->result));
+                }
+            }
+        };
+
+        template<receiver ReceiverT, typename TimeT>
+        struct timer_operation_state :
+            reactor_operation<timer_operation_state<ReceiverT, TimeT>, timer_base, ReceiverT>
+        {
+            using base_t = reactor_operation<timer_operation_state, timer_base, ReceiverT>;
+
+            explicit timer_operation_state(epoll_context* context, TimeT time, ReceiverT receiver) noexcept :
+                base_t(context, std::move(receiver)),
+                time(time) {}
+
+            TimeT time;
+
+            void begin() noexcept {
+                if constexpr (std::is_same_v<TimeT, duration>) {
+                    this->context->add_timer(this, clock::now() + time);
+                }
+                else {
+                    this->context->add_timer(this, time);
+                }
+
+                this->state = timer_base::op_state::registered;
+            }
+
+            void unregister() noexcept {
+                this->context->m_wheel.remove(this);
+            }
+
+            void deliver() noexcept {
+                if (this->stopped) {
+                    set_stopped(std::move(this->receiver));
+                }
+                else {
+                    set_value(std::move(this->receiver));
+                }
+            }
+        };
+
+        struct env {
+            epoll_context* context;
+
+            [[nodiscard]] constexpr auto query(get_completion_scheduler_t<set_value_t>) const noexcept {
+                return context->get_scheduler();
+            }
+
+            [[nodiscard]] constexpr auto query(get_completion_scheduler_t<set_stopped_t>) const noexcept {
+                return context->get_scheduler();
+            }
+        };
+
+        struct scheduler {
+            struct sender {
+                using sender_concept = sender_t;
+
+                using completion_signatures =
+                    completion_signatures<set_value_t(), set_error_t(std::exception_ptr), set_stopped_t()>;
+
+                epoll_context* context;
+
+                [[nodiscard]] auto get_env() const noexcept {
+                    return env{ context };
+                }
+
+                constexpr auto connect(receiver auto&& rcvr) {
+                    return operation_state<std::decay_t<decltype(rcvr)>>(context, std::forward<decltype(rcvr)>(rcvr));
+                }
+            };
+
+            template<typename IoT>
+            struct io_sender {
+                using sender_concept = sender_t;
+
+                using completion_signatures =
+                    completion_signatures<typename IoT::completion_signature,
+                                          set_error_t(std::error_code),
+                                          set_error_t(std::exception_ptr),
+                                          set_stopped_t()>;
+
+                epoll_context* context;
+                int fd;
+                IoT io;
+
+                [[nodiscard]] auto get_env() const noexcept {
+                    return env{ context };
+                }
+
+                constexpr auto connect(receiver auto&& rcvr) {
+                    return io_operation_state<std::decay_t<decltype(rcvr)>, IoT>(
+                        context, fd, io, std::forward<decltype(rcvr)>(rcvr));
+                }
+            };
+
+            template<typename TimeT>
+            struct timer_sender {
+                using sender_concept = sender_t;
+
+                using completion_signatures =
+                    completion_signatures<set_value_t(), set_error_t(std::exception_ptr), set_stopped_t()>;
+
+                epoll_context* context;
+                TimeT time;
+
+                [[nodiscard]] auto get_env() const noexcept {
+                    return env{ context };
+                }
+
+                constexpr auto connect(receiver auto&& rcvr) {
+                    return timer_operation_state<std::decay_t<decltype(rcvr)>, TimeT>(
+                        context, time, std::forward<decltype(rcvr)>(rcvr));
+                }
+            };
+
+            using scheduler_concept = scheduler_t;
+
+            epoll_context* context;
+
+            [[nodiscard]] constexpr sender schedule() const {
+                return sender{ context };
+            }
+
+            [[nodiscard]] constexpr timer_sender<time_point> schedule_at(time_point deadline) const {
+                return timer_sender<time_point>{ context, deadline };
+            }
+
+            [[nodiscard]] constexpr timer_sender<duration> schedule_after(duration delay) const {
+                return timer_sender<duration>{ context, delay };
+            }
+
+            [[nodiscard]] static time_point now() noexcept {
+                return clock::now();
+            }
+
+            [[nodiscard]] constexpr io_sender<read_some_io> async_read_some(int fd, std::span<std::byte> buffer) const {
+                return io_sender<read_some_io>{ context, fd, read_some_io{ buffer } };
+            }
+
+            [[nodiscard]]
+            constexpr io_sender<write_some_io> async_write_some(int fd, std::span<const std::byte> buffer) const {
+                return io_sender<write_some_io>{ context, fd, write_some_io{ buffer } };
+            }
+
+            [[nodiscard]]
+            constexpr io_sender<read_io> async_read(int fd, std::span<std::byte> buffer, std::int64_t offset) const {
+                return io_sender<read_io>{ context, fd, read_io{ buffer, offset } };
+            }
+
+            [[nodiscard]] constexpr io_sender<write_io>
+                async_write(int fd, std::span<const std::byte> buffer, std::int64_t offset) const
+            {
+                return io_sender<write_io>{ context, fd, write_io{ buffer, offset } };
+            }
+
+            [[nodiscard]] constexpr io_sender<fsync_io> async_fsync(int fd) const {
+                return io_sender<fsync_io>{ context, fd, fsync_io{} };
+            }
+
+            [[nodiscard]] constexpr io_sender<accept_io> async_accept(int fd) const {
+                return io_sender<accept_io>{ context, fd, accept_io{} };
+            }
+
+        private:
+            [[nodiscard]]
+            friend constexpr bool operator==(const scheduler& left, const scheduler& right) noexcept {
+                return left.context == right.context;
+            }
+
+        };
+
+    public:
+        epoll_context() :
+            m_epoll(::epoll_create1(EPOLL_CLOEXEC)),
+            m_wakeup(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+        {
+            if (m_epoll < 0 || m_wakeup < 0) {
+                const int error = errno;
+                close_fds();
+                throw std::system_error(error, std::system_category(), "Failed to create epoll context.");
+            }
+
+            ::epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = m_wakeup;
+
+            if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup, &event) < 0) {
+                const int error = errno;
+                close_fds();
+                throw std::system_error(error, std::system_category(), "Failed to create epoll context.");
+            }
+        }
+
+        epoll_context(epoll_context&&) = delete;
+
+        ~epoll_context() noexcept {
+            while (m_pushers.load(std::memory_order_acquire) != 0) {
+                std::this_thread::yield();
+            }
+
+            if (!m_queue.empty() || !m_fds.empty() || !m_wheel.empty() ||
+                !m_finished.load(std::memory_order_acquire)) {
+                std::terminate();
+            }
+
+            close_fds();
+        }
+
+        constexpr scheduler get_scheduler() noexcept {
+            return scheduler{ this };
+        }
+
+        // Must not be called from several threads at once.
+        void run() {
+            auto* const previous = std::exchange(this_context, this);
+
+            try {
+                while (true) {
+                    bool progressed = run_tasks();
+                    progressed = run_timers() || progressed;
+
+                    if (m_finished.load(std::memory_order_seq_cst)) {
+                        if (!m_fds.empty() || !m_wheel.empty()) {
+                            stop_waiters();
+                            continue;
+                        }
+
+                        if (drained()) {
+                            break;
+                        }
+
+                        if (m_queue.empty()) {
+                            std::this_thread::yield();
+                        }
+
+                        continue;
+                    }
+
+                    poll(progressed || !m_queue.empty() ? 0 : poll_timeout());
+                }
+            }
+            catch (...) {
+                this_context = previous;
+                throw;
+            }
+
+            this_context = previous;
+        }
+
+        // Pending I/O and timers complete with set_stopped once run() observes the request.
+        void finish() noexcept {
+            const push_scope scope(this);
+
+            m_finished.store(true, std::memory_order_seq_cst);
+            signal();
+        }
+
+    private:
+        // Registers a call that may touch the context from another thread than the reactor. The finished check made
+        // under it and finish() are sequentially consistent, so either the check sees finish() or run(), once it has
+        // seen finish(), waits in drained() for the call to be done with the queue and the wakeup descriptor.
+        struct push_scope {
+            explicit push_scope(epoll_context* context) noexcept : context(context) {
+                context->m_pushers.fetch_add(1, std::memory_order_seq_cst);
+            }
+
+            ~push_scope() noexcept {
+                context->m_pushers.fetch_sub(1, std::memory_order_release);
+            }
+
+            push_scope(push_scope&&) = delete;
+
+            epoll_context* context;
+        };
+
+        [[nodiscard]] bool on_reactor_thread() const noexcept {
+            return this_context == this;
+        }
+
+        void ensure_running() const {
+            if (m_finished.load(std::memory_order_seq_cst)) {
+                throw std::runtime_error("Invalid operation on finished epoll context.");
+            }
+        }
+
+        void push_back(details::intrusive_task* task) {
+            const push_scope scope(this);
+
+            ensure_running();
+            post(task);
+        }
+
+        void post(details::intrusive_task* task) noexcept {
+            const push_scope scope(this);
+
+            m_queue.push(task);
+
+            if (!on_reactor_thread() && !m_notified.exchange(true, std::memory_order_seq_cst)) {
+                signal();
+            }
+        }
+
+        // Called once m_finished has been observed. The pushers are read before the queue, a post that had
+        // deregistered is then visible in it.
+        [[nodiscard]] bool drained() const noexcept {
+            return m_pushers.load(std::memory_order_seq_cst) == 0 && m_queue.empty();
+        }
+
+        void signal() noexcept {
+            const std::uint64_t value = 1;
+            [[maybe_unused]] const auto result = ::write(m_wakeup, &value, sizeof(value));
+        }
+
+        bool run_tasks() {
+            auto tasks = m_queue.pop_all();
+            if (tasks.empty()) {
+                return false;
+            }
+
+            while (auto* task = tasks.pop_front()) {
+                task->execute();
+            }
+
+            return true;
+        }
+
+        bool run_timers() noexcept {
+            if (m_wheel.empty()) {
+                return false;
+            }
+
+            const auto tick = current_tick();
+            if (tick < m_wheel.next_tick()) {
+                return false;
+            }
+
+            details::intrusive_queue<details::timer_node> expired;
+            m_wheel.advance(tick, expired);
+
+            const bool progressed = !expired.empty();
+            while (auto* node = expired.pop_front()) {
+                auto* const timer = static_cast<timer_base*>(node);
+                timer->complete(timer);
+            }
+
+            return progressed;
+        }
+
+        void add_timer(timer_base* timer, time_point deadline) noexcept {
+            timer->deadline = deadline <= m_epoch ?
+                0 :
+                static_cast<std::uint64_t>(std::chrono::ceil<tick_duration>(deadline - m_epoch).count());
+
+            m_wheel.insert(timer);
+        }
+
+        [[nodiscard]] std::uint64_t current_tick() const noexcept {
+            return static_cast<std::uint64_t>(std::chrono::floor<tick_duration>(clock::now() - m_epoch).count());
+        }
+
+        [[nodiscard]] int poll_timeout() const noexcept {
+            if (m_wheel.empty()) {
+                return -1;
+            }
+
+            const auto next = m_wheel.next_tick();
+            const auto now = current_tick();
+
+            return next <= now ? 0 : static_cast<int>(std::min<std::uint64_t>(next - now, INT_MAX));
+        }
+
+        void poll(int timeout) {
+            std::array<::epoll_event, 64> events;
+
+            const int count = ::epoll_wait(m_epoll, events.data(), static_cast<int>(events.size()), timeout);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    return;
+                }
+
+                throw std::system_error(errno, std::system_category(), "epoll_wait failed.");
+            }
+
+            for (int i = 0; i < count; ++i) {
+                const int fd = events[i].data.fd;
+                const std::uint32_t flags = events[i].events;
+
+                if (fd == m_wakeup) {
+                    std::uint64_t value{};
+                    [[maybe_unused]] const auto result = ::read(m_wakeup, &value, sizeof(value));
+                    m_notified.store(false, std::memory_order_seq_cst);
+                    continue;
+                }
+
+                if ((flags & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0) {
+                    process(fd, false);
+                }
+
+                if ((flags & (EPOLLOUT | EPOLLHUP | EPOLLERR)) != 0) {
+                    process(fd, true);
+                }
+            }
+        }
+
+        // Completions run inline and may start or cancel I/O on the same fd, so the state is looked up again
+        // for every waiter.
+        void process(int fd, bool writing) noexcept {
+            while (true) {
+                const auto it = m_fds.find(fd);
+                if (it == m_fds.end()) {
+                    return;
+                }
+
+                auto* const op = (writing ? it->second.writers : it->second.readers).head;
+                if (op == nullptr || !op->perform(op)) {
+                    return;
+                }
+
+                remove_waiter(op);
+                op->complete(op);
+            }
+        }
+
+        void stop_waiters() noexcept {
+            while (!m_fds.empty()) {
+                auto& state = m_fds.begin()->second;
+                auto* const op = state.readers.head != nullptr ? state.readers.head : state.writers.head;
+
+                remove_waiter(op);
+                op->stopped = true;
+                op->complete(op);
+            }
+
+            details::intrusive_queue<details::timer_node> pending;
+            m_wheel.take_all(pending);
+
+            while (auto* node = pending.pop_front()) {
+                auto* const timer = static_cast<timer_base*>(node);
+                timer->stopped = true;
+                timer->complete(timer);
+            }
+        }
+
+        [[nodiscard]] std::error_code add_waiter(io_base* op) noexcept {
+            fd_state* state{};
+            try {
+                state = &m_fds[op->fd];
+            }
+            catch (...) {
+                return std::make_error_code(std::errc::not_enough_memory);
+            }
+
+            auto& list = op->writing ? state->writers : state->readers;
+            op->prev_waiter = list.tail;
+            op->next_waiter = nullptr;
+
+            if (list.tail != nullptr) {
+                list.tail->next_waiter = op;
+            }
+            else {
+                list.head = op;
+            }
+
+            list.tail = op;
+
+            if (const auto ec = update_interest(op->fd, *state)) {
+                remove_waiter(op);
+                return ec;
+            }
+
+            return {};
+        }
+
+        void remove_waiter(io_base* op) noexcept {
+            const auto it = m_fds.find(op->fd);
+            auto& list = op->writing ? it->second.writers : it->second.readers;
+
+            if (op->prev_waiter != nullptr) {
+                op->prev_waiter->next_waiter = op->next_waiter;
+            }
+            else {
+                list.head = op->next_waiter;
+            }
+
+            if (op->next_waiter != nullptr) {
+                op->next_waiter->prev_waiter = op->prev_waiter;
+            }
+            else {
+                list.tail = op->prev_waiter;
+            }
+
+            op->prev_waiter = nullptr;
+            op->next_waiter = nullptr;
+
+            [[maybe_unused]] const auto ec = update_interest(op->fd, it->second);
+            if (it->second.events == 0) {
+                m_fds.erase(it);
+            }
+        }
+
+        [[nodiscard]] std::error_code update_interest(int fd, fd_state& state) noexcept {
+            const std::uint32_t events = (state.readers.head != nullptr ? EPOLLIN : 0u) |
+                                         (state.writers.head != nullptr ? EPOLLOUT : 0u);
+            if (events == state.events) {
+                return {};
+            }
+
+            ::epoll_event event{};
+            event.events = events;
+            event.data.fd = fd;
+
+            const int operation = state.events == 0 ? EPOLL_CTL_ADD : events == 0 ? EPOLL_CTL_DEL : EPOLL_CTL_MOD;
+            if (::epoll_ctl(m_epoll, operation, fd, &event) < 0) {
+                if (operation == EPOLL_CTL_DEL) {
+                    state.events = 0;
+                }
+
+                return std::error_code(errno, std::system_category());
+            }
+
+            state.events = events;
+            return {};
+        }
+
+        void close_fds() noexcept {
+            if (m_wakeup >= 0) {
+                ::close(m_wakeup);
+            }
+
+            if (m_epoll >= 0) {
+                ::close(m_epoll);
+            }
+        }
+
+        static inline thread_local epoll_context* this_context{ nullptr };
+
+        int m_epoll;
+        int m_wakeup;
+
+        alignas(64) details::atomic_intrusive_queue<details::intrusive_task> m_queue;
+        alignas(64) std::atomic_size_t m_pushers{ 0 };
+        alignas(64) std::atomic_bool m_notified{ false };
+        std::atomic_bool m_finished{ false };
+
+        std::unordered_map<int, fd_state> m_fds;
+
+        const time_point m_epoch{ clock::now() };
+        details::timer_wheel m_wheel;
+
+    };
+}
+
+#endif // __linux__
+
+#endif // !EXEC_EPOLL_CONTEXT_HPP
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef EXEC_IO_HPP
+#define EXEC_IO_HPP
+
+#include "exec/sender.hpp"
+
+#include <utility>
+
+namespace exec {
+    struct async_read_t {
+        [[nodiscard]] constexpr sender auto operator()(auto&& schd, auto&&... args) const {
+            return std::forward<decltype(schd)>(schd).async_read(std::forward<decltype(args)>(args)...);
+        }
+    };
+    inline constexpr async_read_t async_read{};
+
+    struct async_write_t {
+        [[nodiscard]] constexpr sender auto operator()(auto&& schd, auto&&... args) const {
+            return std::forward<decltype(schd)>(schd).async_write(std::forward<decltype(args)>(args)...);
+        }
+    };
+    inline constexpr async_write_t async_write{};
+
+    struct async_fsync_t {
+        [[nodiscard]] constexpr sender auto operator()(auto&& schd, auto&&... args) const {
+            return std::forward<decltype(schd)>(schd).async_fsync(std::forward<decltype(args)>(args)...);
+        }
+    };
+    inline constexpr async_fsync_t async_fsync{};
+
+    struct async_read_some_t {
+        [[nodiscard]] constexpr sender auto operator()(auto&& schd, auto&&... args) const {
+            return std::forward<decltype(schd)>(schd).async_read_some(std::forward<decltype(args)>(args)...);
+        }
+    };
+    inline constexpr async_read_some_t async_read_some{};
+
+    struct async_write_some_t {
+        [[nodiscard]] constexpr sender auto operator()(auto&& schd, auto&&... args) const {
+            return std::forward<decltype(schd)>(schd).async_write_some(std::forward<decltype(args)>(args)...);
+        }
+    };
+    inline constexpr async_write_some_t async_write_some{};
+
+    struct async_accept_t {
+        [[nodiscard]] constexpr sender auto operator()(auto&& schd, auto&&... args) const {
+            return std::forward<decltype(schd)>(schd).async_accept(std::forward<decltype(args)>(args)...);
+        }
+    };
+    inline constexpr async_accept_t async_accept{};
+}
+
+#endif // !EXEC_IO_HPP
\ No newline at end of file
@@ -0,0 +1,842 @@
+#ifndef EXEC_IO_URING_CONTEXT_HPP
+#define EXEC_IO_URING_CONTEXT_HPP
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+
+#include "exec/completions.hpp"
+#include "exec/completion_signatures.hpp"
+#include "exec/env.hpp"
+#include "exec/epoll_context.hpp"
+#include "exec/io.hpp"
+#include "exec/operation_state.hpp"
+#include "exec/receiver.hpp"
+#include "exec/scheduler.hpp"
+#include "exec/sender.hpp"
+#include "exec/stop_token.hpp"
+#include "exec/timed_scheduler.hpp"
+
+#include "exec/details/atomic_intrusive_queue.hpp"
+#include "exec/details/basic_sender.hpp"
+#include "exec/details/emplace_from.hpp"
+#include "exec/details/intrusive_task.hpp"
+#include "exec/details/io_uring_ring.hpp"
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace exec::details {
+    struct io_uring_op_t {};
+}
+
+namespace exec {
+    // Proactor on io_uring. Operations started during one iteration of run() are submitted together with a single
+    // io_uring_enter, which also waits for completions when there is nothing else to do. Completions are delivered
+    // inline on the thread calling run(). If the kernel refuses io_uring at construction, every sender transparently
+    // runs on an internal epoll_context instead.
+    class io_uring_context {
+        friend struct details::impls_for<details::io_uring_op_t>;
+
+    public:
+        using clock = std::chrono::steady_clock;
+        using time_point = clock::time_point;
+        using duration = clock::duration;
+
+    private:
+        struct completion_base : details::intrusive_task {
+            using complete_fn = void(completion_base*, std::int32_t) noexcept;
+
+            explicit completion_base(execute_fn* execute, complete_fn* complete) noexcept :
+                intrusive_task(execute),
+                complete(complete) {}
+
+            complete_fn* complete;
+
+            completion_base* prev_inflight{ nullptr };
+            completion_base* next_inflight{ nullptr };
+
+            completion_base* next_deferred{ nullptr };
+            std::int32_t deferred_result{ 0 };
+        };
+
+        struct wakeup_node : completion_base {
+            explicit wakeup_node(io_uring_context* context) noexcept :
+                completion_base(nullptr, &wakeup_node::on_wakeup),
+                context(context) {}
+
+            static void on_wakeup(completion_base* base, std::int32_t) noexcept {
+                auto* const context = static_cast<wakeup_node*>(base)->context;
+
+                context->m_notified.store(false, std::memory_order_seq_cst);
+                context->m_wakeup_armed = false;
+                context->arm_wakeup();
+            }
+
+            io_uring_context* context;
+        };
+
+        using fallback_scheduler = decltype(std::declval<epoll_context&>().get_scheduler());
+
+        template<typename... SignatureTs>
+        using io_signatures_t =
+            completion_signatures<SignatureTs...,
+                                  set_error_t(std::error_code),
+                                  set_error_t(std::exception_ptr),
+                                  set_stopped_t()>;
+
+        struct schedule_op {
+            using completion_signatures =
+                completion_signatures<set_value_t(), set_error_t(std::exception_ptr), set_stopped_t()>;
+
+            static constexpr bool needs_sqe = false;
+
+            [[nodiscard]] auto fallback(fallback_scheduler schd) const {
+                return exec::schedule(schd);
+            }
+        };
+
+        struct read_op {
+            using completion_signatures = io_signatures_t<set_value_t(std::size_t)>;
+
+            static constexpr bool needs_sqe = true;
+
+            int fd;
+            std::span<std::byte> buffer;
+            std::int64_t offset;
+
+            void prepare(::io_uring_sqe& sqe) noexcept {
+                sqe.opcode = IORING_OP_READ;
+                sqe.fd = fd;
+                sqe.addr = reinterpret_cast<std::uint64_t>(buffer.data());
+                sqe.len = static_cast<std::uint32_t>(buffer.size());
+                sqe.off = static_cast<std::uint64_t>(offset);
+            }
+
+            [[nodiscard]] auto fallback(fallback_scheduler schd) const {
+                return exec::async_read(schd, fd, buffer, offset);
+            }
+        };
+
+        struct write_op {
+            using completion_signatures = io_signatures_t<set_value_t(std::size_t)>;
+
+            static constexpr bool needs_sqe = true;
+
+            int fd;
+            std::span<const std::byte> buffer;
+            std::int64_t offset;
+
+            void prepare(::io_uring_sqe& sqe) noexcept {
+                sqe.opcode = IORING_OP_WRITE;
+                sqe.fd = fd;
+                sqe.addr = reinterpret_cast<std::uint64_t>(buffer.data());
+                sqe.len = static_cast<std::uint32_t>(buffer.size());
+                sqe.off = static_cast<std::uint64_t>(offset);
+            }
+
+            [[nodiscard]] auto fallback(fallback_scheduler schd) const {
+                return exec::async_write(schd, fd, buffer, offset);
+            }
+        };
+
+        struct fsync_op {
+            using completion_signatures = io_signatures_t<set_value_t()>;
+
+            static constexpr bool needs_sqe = true;
+
+            int fd;
+
+            void prepare(::io_uring_sqe& sqe) noexcept {
+                sqe.opcode = IORING_OP_FSYNC;
+                sqe.fd = fd;
+            }
+
+            [[nodiscard]] auto fallback(fallback_scheduler schd) const {
+                return exec::async_fsync(schd, fd);
+            }
+        };
+
+        // The kernel reads the timespec when the SQE is submitted, it lives in the operation state until then.
+        template<typename TimeT>
+        struct timeout_op {
+            using completion_signatures = io_signatures_t<set_value_t()>;
+
+            static constexpr bool needs_sqe = true;
+
+            TimeT time;
+            ::__kernel_timespec timespec{};
+
+            void prepare(::io_uring_sqe& sqe) noexcept {
+                const auto since_epoch = std::chrono::ceil<std::chrono::nanoseconds>([this] {
+                    if constexpr (std::is_same_v<TimeT, duration>) {
+                        return time;
+                    }
+                    else {
+                        return time.time_since_epoch();
+                    }
+                }());
+
+                const auto seconds = std::chrono::floor<std::chrono::seconds>(since_epoch);
+                timespec.tv_sec = seconds.count();
+                timespec.tv_nsec = (since_epoch - seconds).count();
+
+                sqe.opcode = IORING_OP_TIMEOUT;
+                sqe.fd = -1;
+                sqe.addr = reinterpret_cast<std::uint64_t>(&timespec);
+                sqe.len = 1;
+                sqe.timeout_flags = std::is_same_v<TimeT, duration> ? 0u : IORING_TIMEOUT_ABS;
+            }
+
+            [[nodiscard]] auto fallback(fallback_scheduler schd) const {
+                if constexpr (std::is_same_v<TimeT, duration>) {
+                    return exec::schedule_after(schd, time);
+                }
+                else {
+                    return exec::schedule_at(schd, time);
+                }
+            }
+        };
+
+        template<typename OpT>
+        struct io_data {
+            io_uring_context* context;
+            OpT op;
+        };
+
+        struct env {
+            io_uring_context* context;
+
+            [[nodiscard]] constexpr auto query(get_completion_scheduler_t<set_value_t>) const noexcept {
+                return context->get_scheduler();
+            }
+
+            [[nodiscard]] constexpr auto query(get_completion_scheduler_t<set_stopped_t>) const noexcept {
+                return context->get_scheduler();
+            }
+        };
+
+        struct scheduler {
+            using scheduler_concept = scheduler_t;
+
+            io_uring_context* context;
+
+            [[nodiscard]] constexpr auto schedule() const {
+                return details::make_sender(details::io_uring_op_t{}, io_data<schedule_op>{ context, {} });
+            }
+
+            [[nodiscard]] constexpr auto schedule_at(time_point deadline) const {
+                return details::make_sender(details::io_uring_op_t{},
+                                            io_data<timeout_op<time_point>>{ context, { deadline } });
+            }
+
+            [[nodiscard]] constexpr auto schedule_after(duration delay) const {
+                return details::make_sender(details::io_uring_op_t{},
+                                            io_data<timeout_op<duration>>{ context, { delay } });
+            }
+
+            [[nodiscard]] static time_point now() noexcept {
+                return clock::now();
+            }
+
+            // A negative offset reads from the current file position.
+            [[nodiscard]] constexpr auto async_read(int fd, std::span<std::byte> buffer, std::int64_t offset) const {
+                return details::make_sender(details::io_uring_op_t{},
+                                            io_data<read_op>{ context, { fd, buffer, offset } });
+            }
+
+            [[nodiscard]]
+            constexpr auto async_write(int fd, std::span<const std::byte> buffer, std::int64_t offset) const {
+                return details::make_sender(details::io_uring_op_t{},
+                                            io_data<write_op>{ context, { fd, buffer, offset } });
+            }
+
+            [[nodiscard]] constexpr auto async_fsync(int fd) const {
+                return details::make_sender(details::io_uring_op_t{}, io_data<fsync_op>{ context, { fd } });
+            }
+
+        private:
+            [[nodiscard]]
+            friend constexpr bool operator==(const scheduler& left, const scheduler& right) noexcept {
+                return left.context == right.context;
+            }
+
+        };
+
+    public:
+        explicit io_uring_context(unsigned entries = 256) {
+            try {
+                m_ring.emplace(entries);
+            }
+            catch (const std::system_error&) {
+                m_fallback.emplace();
+                return;
+            }
+
+            m_wakeup = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (m_wakeup < 0) {
+                throw std::system_error(errno, std::system_category(), "Failed to create io_uring context.");
+            }
+        }
+
+        io_uring_context(io_uring_context&&) = delete;
+
+        ~io_uring_context() noexcept {
+            if (m_fallback.has_value()) {
+                return;
+            }
+
+            while (m_pushers.load(std::memory_order_acquire) != 0) {
+                std::this_thread::yield();
+            }
+
+            if (!m_queue.empty() || m_inflight != nullptr || !m_finished.load(std::memory_order_acquire)) {
+                std::terminate();
+            }
+
+            // Closing the ring first cancels the pending wake-up read.
+            m_ring.reset();
+            ::close(m_wakeup);
+        }
+
+        constexpr scheduler get_scheduler() noexcept {
+            return scheduler{ this };
+        }
+
+        [[nodiscard]] bool uses_io_uring() const noexcept {
+            return m_ring.has_value();
+        }
+
+        // Must not be called from several threads at once.
+        void run() {
+            if (m_fallback.has_value()) {
+                m_fallback->run();
+                return;
+            }
+
+            auto* const previous = std::exchange(this_context, this);
+
+            try {
+                while (true) {
+                    arm_wakeup();
+
+                    bool progressed = run_tasks();
+
+                    if (m_finished.load(std::memory_order_seq_cst)) {
+                        cancel_inflight();
+
+                        if (m_inflight == nullptr) {
+                            if (drained()) {
+                                break;
+                            }
+
+                            // Only a call still registered can add work, it may not signal, so do not block.
+                            if (m_queue.empty()) {
+                                std::this_thread::yield();
+                            }
+
+                            progressed = true;
+                        }
+                    }
+
+                    const bool idle = !progressed && m_queue.empty() && m_deferred == nullptr;
+                    const int result = m_ring->submit(idle ? 1 : 0);
+                    if (result < 0 && result != -EINTR && result != -EAGAIN && result != -EBUSY) {
+                        throw std::system_error(-result, std::system_category(), "io_uring_enter failed.");
+                    }
+
+                    complete_deferred();
+                    m_ring->reap([this](std::uint64_t user_data, std::int32_t res) noexcept {
+                        // Cancellation requests carry no user data.
+                        if (user_data != 0) {
+                            complete(reinterpret_cast<completion_base*>(user_data), res);
+                        }
+                    });
+                }
+
+                // Publish the cancellations of the last iteration.
+                [[maybe_unused]] const int result = m_ring->submit(0);
+            }
+            catch (...) {
+                this_context = previous;
+                throw;
+            }
+
+            this_context = previous;
+        }
+
+        // Operations in flight are cancelled and complete with set_stopped before run() returns.
+        void finish() noexcept {
+            if (m_fallback.has_value()) {
+                m_fallback->finish();
+                return;
+            }
+
+            const push_scope scope(this);
+
+            m_finished.store(true, std::memory_order_seq_cst);
+            signal();
+        }
+
+    private:
+        // Registers a call that may touch the context from another thread than the ring's. The finished check made
+        // under it and finish() are sequentially consistent, so either the check sees finish() or run(), once it has
+        // seen finish(), waits in drained() for the call to be done with the queue and the wakeup descriptor.
+        struct push_scope {
+            explicit push_scope(io_uring_context* context) noexcept : context(context) {
+                context->m_pushers.fetch_add(1, std::memory_order_seq_cst);
+            }
+
+            ~push_scope() noexcept {
+                context->m_pushers.fetch_sub(1, std::memory_order_release);
+            }
+
+            push_scope(push_scope&&) = delete;
+
+            io_uring_context* context;
+        };
+
+        [[nodiscard]] bool on_ring_thread() const noexcept {
+            return this_context == this;
+        }
+
+        [[nodiscard]] bool finished() const noexcept {
+            return m_finished.load(std::memory_order_acquire);
+        }
+
+        void ensure_running() const {
+            if (m_finished.load(std::memory_order_seq_cst)) {
+                throw std::runtime_error("Invalid operation on finished io_uring context.");
+            }
+        }
+
+        void post(details::intrusive_task* task) noexcept {
+            const push_scope scope(this);
+
+            m_queue.push(task);
+
+            if (!on_ring_thread() && !m_notified.exchange(true, std::memory_order_seq_cst)) {
+                signal();
+            }
+        }
+
+        // Called once m_finished has been observed. The pushers are read before the queue, a post that had
+        // deregistered is then visible in it.
+        [[nodiscard]] bool drained() const noexcept {
+            return m_pushers.load(std::memory_order_seq_cst) == 0 && m_queue.empty();
+        }
+
+        void signal() noexcept {
+            const std::uint64_t value = 1;
+            [[maybe_unused]] const auto result = ::write(m_wakeup, &value, sizeof(value));
+        }
+
+        bool run_tasks() {
+            auto tasks = m_queue.pop_all();
+            if (tasks.empty()) {
+                return false;
+            }
+
+            while (auto* task = tasks.pop_front()) {
+                task->execute();
+            }
+
+            return true;
+        }
+
+        void complete(completion_base* op, std::int32_t res) noexcept {
+            if (op != &m_wakeup_node) {
+                untrack(op);
+            }
+
+            op->complete(op, res);
+        }
+
+        void complete_deferred() noexcept {
+            while (auto* const op = m_deferred) {
+                m_deferred = op->next_deferred;
+                op->next_deferred = nullptr;
+
+                complete(op, op->deferred_result);
+            }
+        }
+
+        // Returns 0 or -errno. With the completion queue full the kernel refuses new submissions until completions
+        // are reaped. They are only set aside here, as the caller may be walking the in-flight list or running a
+        // completion itself, and run() delivers them on its next iteration.
+        [[nodiscard]] int get_sqe(::io_uring_sqe*& sqe) noexcept {
+            sqe = m_ring->try_get_sqe();
+            while (sqe == nullptr) {
+                const int result = m_ring->submit(0);
+                if (result == -EBUSY || result == -EAGAIN) {
+                    if (defer_completions() == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+                else if (result < 0 && result != -EINTR) {
+                    return result;
+                }
+
+                sqe = m_ring->try_get_sqe();
+            }
+
+            return 0;
+        }
+
+        std::size_t defer_completions() noexcept {
+            return m_ring->reap([this](std::uint64_t user_data, std::int32_t res) noexcept {
+                if (user_data == 0) {
+                    return;
+                }
+
+                auto* const op = reinterpret_cast<completion_base*>(user_data);
+                op->deferred_result = res;
+                op->next_deferred = m_deferred;
+                m_deferred = op;
+            });
+        }
+
+        // Returns 0 or -errno, the operation is only tracked once its SQE has been prepared.
+        [[nodiscard]] int submit(completion_base* op, auto&& prepare) noexcept {
+            ::io_uring_sqe* sqe = nullptr;
+            if (const int result = get_sqe(sqe); result < 0) {
+                return result;
+            }
+
+            prepare(*sqe);
+            sqe->user_data = reinterpret_cast<std::uint64_t>(op);
+
+            op->prev_inflight = nullptr;
+            op->next_inflight = m_inflight;
+            if (m_inflight != nullptr) {
+                m_inflight->prev_inflight = op;
+            }
+
+            m_inflight = op;
+            return 0;
+        }
+
+        void untrack(completion_base* op) noexcept {
+            if (op->prev_inflight != nullptr) {
+                op->prev_inflight->next_inflight = op->next_inflight;
+            }
+            else {
+                m_inflight = op->next_inflight;
+            }
+
+            if (op->next_inflight != nullptr) {
+                op->next_inflight->prev_inflight = op->prev_inflight;
+            }
+
+            op->prev_inflight = nullptr;
+            op->next_inflight = nullptr;
+        }
+
+        // Best effort, a ring refusing submissions fails the next io_uring_enter of run() as well.
+        void cancel(completion_base* op) noexcept {
+            ::io_uring_sqe* sqe = nullptr;
+            if (get_sqe(sqe) < 0) {
+                return;
+            }
+
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->addr = reinterpret_cast<std::uint64_t>(op);
+        }
+
+        void cancel_inflight() noexcept {
+            if (m_cancelled_inflight) {
+                return;
+            }
+
+            m_cancelled_inflight = true;
+            for (auto* op = m_inflight; op != nullptr; op = op->next_inflight) {
+                cancel(op);
+            }
+        }
+
+        void arm_wakeup() noexcept {
+            if (m_wakeup_armed) {
+                return;
+            }
+
+            // Retried by the next iteration of run() if the ring refuses the read.
+            ::io_uring_sqe* sqe = nullptr;
+            if (get_sqe(sqe) < 0) {
+                return;
+            }
+
+            m_wakeup_armed = true;
+
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = m_wakeup;
+            sqe->addr = reinterpret_cast<std::uint64_t>(&m_wakeup_value);
+            sqe->len = sizeof(m_wakeup_value);
+            sqe->user_data = reinterpret_cast<std::uint64_t>(static_cast<completion_base*>(&m_wakeup_node));
+        }
+
+        static inline thread_local io_uring_context* this_context{ nullptr };
+
+        std::optional<details::io_uring_ring> m_ring;
+        std::optional<epoll_context> m_fallback;
+
+        alignas(64) details::atomic_intrusive_queue<details::intrusive_task> m_queue;
+        alignas(64) std::atomic_size_t m_pushers{ 0 };
+        alignas(64) std::atomic_bool m_notified{ false };
+        std::atomic_bool m_finished{ false };
+
+        int m_wakeup{ -1 };
+        std::uint64_t m_wakeup_value{ 0 };
+        wakeup_node m_wakeup_node{ this };
+        bool m_wakeup_armed{ false };
+
+        completion_base* m_inflight{ nullptr };
+        completion_base* m_deferred{ nullptr };
+        bool m_cancelled_inflight{ false };
+
+    };
+
+    template<>
+    struct details::impls_for<details::io_uring_op_t> : default_impls {
+        template<typename ReceiverT>
+        struct receiver_ref {
+            using receiver_concept = exec::receiver_t;
+
+            ReceiverT& rcvr;
+
+            template<typename... Ts>
+            void set_value(Ts&&... values) && noexcept {
+                exec::set_value(std::move(rcvr), std::forward<Ts>(values)...);
+            }
+
+            template<typename T>
+            void set_error(T&& value) && noexcept {
+                exec::set_error(std::move(rcvr), std::forward<T>(value));
+            }
+
+            void set_stopped() && noexcept {
+                exec::set_stopped(std::move(rcvr));
+            }
+
+            [[nodiscard]] constexpr decltype(auto) get_env() const noexcept {
+                return exec::get_env(rcvr);
+            }
+        };
+
+        template<typename OpT, typename ReceiverT>
+        struct state : io_uring_context::completion_base {
+            enum class op_state : std::uint8_t {
+                pending,
+                submitted,
+                cancelled,
+                deferred
+            };
+
+            struct cancel_task : intrusive_task {
+                explicit cancel_task(state* self) noexcept : intrusive_task(&state::cancel), self(self) {}
+
+                state* self;
+            };
+
+            struct on_stop {
+                state* self;
+
+                void operator()() const noexcept {
+                    self->cancel_posted.store(true, std::memory_order_release);
+                    self->context->post(&self->cancel_node);
+                }
+            };
+
+            using fallback_sender_t = decltype(std::declval<const OpT&>().fallback(std::declval<io_uring_context::fallback_scheduler>()));
+            using fallback_op_t = connect_result_t<fallback_sender_t, receiver_ref<ReceiverT>>;
+
+            using stop_token_t = stop_token_of_t<env_of_t<ReceiverT>>;
+            using stop_callback_t = typename stop_token_t::template callback_type<on_stop>;
+
+            explicit state(io_uring_context* context, OpT op, ReceiverT& receiver) noexcept :
+                completion_base(&state::prepare, &state::on_complete),
+                context(context),
+                op(op),
+                receiver(receiver) {}
+
+            state(state&&) = delete;
+
+            io_uring_context* context;
+            OpT op;
+            ReceiverT& receiver;
+
+            std::optional<stop_callback_t> stop_callback{};
+            cancel_task cancel_node{ this };
+            std::optional<fallback_op_t> fallback{};
+
+            op_state status{ op_state::pending };
+            std::atomic_bool cancel_posted{ false };
+            bool cancel_handled{ false };
+            std::int32_t result{ 0 };
+
+            void run() noexcept {
+                if (context->m_fallback.has_value()) {
+                    auto make_op = [this] {
+                        return exec::connect(op.fallback(context->m_fallback->get_scheduler()),
+                                             receiver_ref<ReceiverT>{ receiver });
+                    };
+
+                    exec::start(fallback.emplace(emplace_from{ make_op }));
+                    return;
+                }
+
+                auto token = get_stop_token(exec::get_env(receiver));
+                if (token.stop_requested()) {
+                    exec::set_stopped(std::move(receiver));
+                    return;
+                }
+
+                // Registered until the operation is posted, run() cannot return in between.
+                const io_uring_context::push_scope scope(context);
+
+                try {
+                    context->ensure_running();
+                }
+                catch (...) {
+                    exec::set_error(std::move(receiver), std::current_exception());
+                    return;
+                }
+
+                stop_callback.emplace(token, on_stop{ this });
+
+                if (context->on_ring_thread()) {
+                    prepare(this);
+                }
+                else {
+                    context->post(this);
+                }
+            }
+
+            static void prepare(intrusive_task* task) noexcept {
+                auto& self = *static_cast<state*>(task);
+
+                if (self.status == op_state::cancelled) {
+                    self.stop_callback.reset();
+                    exec::set_stopped(std::move(self.receiver));
+                    return;
+                }
+
+                if constexpr (OpT::needs_sqe) {
+                    if (self.context->finished()) {
+                        on_complete(&self, -ECANCELED);
+                        return;
+                    }
+
+                    const int result =
+                        self.context->submit(&self, [&](::io_uring_sqe& sqe) noexcept { self.op.prepare(sqe); });
+                    if (result < 0) {
+                        on_complete(&self, result);
+                        return;
+                    }
+
+                    self.status = op_state::submitted;
+                }
+                else {
+                    on_complete(&self, 0);
+                }
+            }
+
+            static void on_complete(completion_base* base, std::int32_t result) noexcept {
+                auto& self = *static_cast<state*>(base);
+                self.result = result;
+
+                // A stop callback that already ran has queued the cancel task, which must run before the operation
+                // may complete and be destroyed.
+                self.stop_callback.reset();
+                if (self.cancel_posted.load(std::memory_order_acquire) && !self.cancel_handled) {
+                    self.status = op_state::deferred;
+                    return;
+                }
+
+                self.deliver();
+            }
+
+            static void cancel(intrusive_task* task) noexcept {
+                auto& self = *static_cast<cancel_task*>(task)->self;
+                self.cancel_handled = true;
+
+                switch (self.status) {
+                    case op_state::pending:
+                        self.status = op_state::cancelled;
+                        break;
+                    case op_state::submitted:
+                        self.context->cancel(&self);
+                        break;
+                    case op_state::deferred:
+                        self.deliver();
+                        break;
+                    case op_state::cancelled:
+                        break;
+                }
+            }
+
+            void deliver() noexcept {
+                constexpr bool is_timeout = requires { op.timespec; };
+
+                if (result == -ECANCELED) {
+                    exec::set_stopped(std::move(receiver));
+                }
+                else if constexpr (!OpT::needs_sqe) {
+                    // Nothing was submitted, a schedule completes with a value and declares no error_code.
+                    exec::set_value(std::move(receiver));
+                }
+                else if (result < 0 && !(is_timeout && result == -ETIME)) {
+                    exec::set_error(std::move(receiver), std::error_code(-result, std::system_category()));
+                }
+                else if constexpr (std::is_same_v<OpT, io_uring_context::read_op> ||
+                                   std::is_same_v<OpT, io_uring_context::write_op>) {
+                    exec::set_value(std::move(receiver), static_cast<std::size_t>(result));
+                }
+                else {
+                    exec::set_value(std::move(receiver));
+                }
+            }
+        };
+
+        static constexpr auto get_attrs =
+            [](const auto& data, const auto&...) noexcept {
+                return io_uring_context::env{ data.context };
+            };
+
+        static constexpr auto get_completion_signatures =
+            []<typename SenderT, typename EnvT>(SenderT&&, EnvT&&) noexcept {
+                using data_t = std::remove_cvref_t<data_of_t<SenderT>>;
+
+                return typename decltype(data_t::op)::completion_signatures{};
+            };
+
+        static constexpr auto get_state =
+            []<typename SenderT, typename ReceiverT>(SenderT&& sender, ReceiverT& receiver) noexcept {
+                auto&& data = get_data(std::forward<SenderT>(sender));
+
+                return state<decltype(data.op), ReceiverT>{ data.context, data.op, receiver };
+            };
+
+        static constexpr auto start =
+            []<typename StateT>(StateT& state, auto&&) noexcept {
+                state.run();
+            };
+    };
+}
+
+#endif // __linux__ && __has_include(<linux/io_uring.h>)
+
+#endif // !EXEC_IO_URING_CONTEXT_HPP
\ No newline at end of file
@@ -0,0 +1,127 @@
+#ifndef EXEC_MONOTONIC_ARENA_HPP
+#define EXEC_MONOTONIC_ARENA_HPP
+
+#include "exec/allocator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+
+namespace exec {
+    // Bump allocator for memory that dies together, such as everything allocated while one pipeline runs.
+    // Deallocation is a no-op, the memory is released all at once by release() or the destructor, neither of which
+    // may run concurrently with allocations. Allocating is thread-safe, it only takes a lock to add a chunk.
+    class monotonic_arena {
+    public:
+        static constexpr std::size_t default_chunk_size = 4096;
+
+        explicit monotonic_arena(std::size_t initial_size = default_chunk_size) noexcept :
+            m_next_size(std::max(initial_size, sizeof(chunk))) {}
+
+        monotonic_arena(monotonic_arena&&) = delete;
+
+        ~monotonic_arena() {
+            release();
+        }
+
+        [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+            for (;;) {
+                chunk* const current = m_current.load(std::memory_order_acquire);
+
+                if (current != nullptr) {
+                    // Reserving the worst case padding keeps the fast path to a single fetch_add.
+                    const std::size_t offset = current->used.fetch_add(size + alignment - 1, std::memory_order_relaxed);
+
+                    if (offset + size + alignment - 1 <= current->size) {
+                        void* ptr = current->data() + offset;
+                        std::size_t space = size + alignment - 1;
+                        return std::align(alignment, size, ptr, space);
+                    }
+                }
+
+                grow(current, size + alignment - 1);
+            }
+        }
+
+        static constexpr void deallocate(void*, std::size_t) noexcept {}
+
+        void release() noexcept {
+            chunk* current = m_current.exchange(nullptr, std::memory_order_acquire);
+
+            while (current != nullptr) {
+                chunk* const prev = current->prev;
+                const std::size_t bytes = sizeof(chunk) + current->size;
+
+                current->~chunk();
+                ::operator delete(current, bytes);
+                current = prev;
+            }
+        }
+
+    private:
+        struct chunk {
+            chunk* prev;
+            std::size_t size;
+            std::atomic_size_t used;
+
+            [[nodiscard]] std::byte* data() noexcept {
+                return reinterpret_cast<std::byte*>(this + 1);
+            }
+        };
+
+        void grow(chunk* full, std::size_t min_size) {
+            std::lock_guard lock(m_mutex);
+
+            if (m_current.load(std::memory_order_relaxed) != full) {
+                return;
+            }
+
+            const std::size_t size = std::max(m_next_size, min_size);
+            void* const memory = ::operator new(sizeof(chunk) + size);
+
+            m_current.store(::new (memory) chunk{ full, size, 0 }, std::memory_order_release);
+            m_next_size = size * 2;
+        }
+
+        std::atomic<chunk*> m_current{ nullptr };
+        std::mutex m_mutex;
+        std::size_t m_next_size;
+
+    };
+
+    // Allocator handing out memory from a monotonic_arena, copies compare equal when they refer to the same arena.
+    template<typename T>
+    class monotonic_allocator {
+    public:
+        using value_type = T;
+
+        constexpr explicit monotonic_allocator(monotonic_arena& arena) noexcept : m_arena(std::addressof(arena)) {}
+
+        template<typename U>
+        constexpr monotonic_allocator(const monotonic_allocator<U>& other) noexcept : m_arena(other.arena()) {}
+
+        [[nodiscard]] T* allocate(std::size_t count) {
+            return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        static constexpr void deallocate(T*, std::size_t) noexcept {}
+
+        [[nodiscard]] constexpr monotonic_arena* arena() const noexcept {
+            return m_arena;
+        }
+
+        template<typename U>
+        [[nodiscard]] friend bool operator==(const monotonic_allocator& lhs, const monotonic_allocator<U>& rhs) noexcept {
+            return lhs.arena() == rhs.arena();
+        }
+
+    private:
+        monotonic_arena* m_arena;
+
+    };
+}
+
+#endif // !EXEC_MONOTONIC_ARENA_HPP
\ No newline at end of file
@@ -0,0 +1,202 @@
+#ifndef EXEC_POOL_ALLOCATOR_HPP
+#define EXEC_POOL_ALLOCATOR_HPP
+
+#include "exec/allocator.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+namespace exec {
+    namespace details {
+        struct pool_block {
+            pool_block* next;
+        };
+
+        struct pool_size_classes {
+            static constexpr std::size_t min_size = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+            static constexpr std::size_t count = 8;
+            static constexpr std::size_t max_size = min_size << (count - 1);
+
+            // Blocks moved between a thread cache and the central pool at once.
+            static constexpr std::size_t batch = 32;
+
+            [[nodiscard]] static constexpr std::size_t index(std::size_t size) noexcept {
+                return size <= min_size ? 0 : std::bit_width(size - 1) - std::bit_width(min_size - 1);
+            }
+
+            [[nodiscard]] static constexpr std::size_t size(std::size_t index) noexcept {
+                return min_size << index;
+            }
+        };
+
+        // Free lists shared by every thread. Blocks are carved from slabs that are never returned to the system, a
+        // block may be freed on a different thread than the one it was allocated on.
+        class pool_central {
+        public:
+            [[nodiscard]] static pool_central& instance() noexcept {
+                static pool_central pool;
+                return pool;
+            }
+
+            // Hands out a chain of `batch` blocks of the given class.
+            [[nodiscard]] pool_block* acquire(std::size_t index) {
+                {
+                    std::lock_guard lock(m_mutex);
+
+                    if (m_free[index] != nullptr) {
+                        pool_block* const first = m_free[index];
+                        pool_block* last = first;
+                        for (std::size_t i = 1; i < pool_size_classes::batch && last->next != nullptr; ++i) {
+                            last = last->next;
+                        }
+
+                        m_free[index] = last->next;
+                        last->next = nullptr;
+                        return first;
+                    }
+                }
+
+                const std::size_t size = pool_size_classes::size(index);
+                auto* const slab = static_cast<std::byte*>(::operator new(size * pool_size_classes::batch));
+
+                pool_block* first = nullptr;
+                for (std::size_t i = pool_size_classes::batch; i-- > 0;) {
+                    first = ::new (slab + i * size) pool_block{ first };
+                }
+                return first;
+            }
+
+            void release(std::size_t index, pool_block* first, pool_block* last) noexcept {
+                std::lock_guard lock(m_mutex);
+
+                last->next = m_free[index];
+                m_free[index] = first;
+            }
+
+        private:
+            pool_central() = default;
+
+            std::mutex m_mutex;
+            pool_block* m_free[pool_size_classes::count]{};
+
+        };
+
+        // Per-thread free lists in front of the central pool. A list growing past twice the batch size, typically on
+        // a thread that frees what others allocated, gives a batch back. Cached blocks go back when the thread exits.
+        class pool_cache {
+        public:
+            pool_cache() = default;
+
+            pool_cache(pool_cache&&) = delete;
+
+            ~pool_cache() {
+                for (std::size_t index = 0; index < pool_size_classes::count; ++index) {
+                    if (m_lists[index].head != nullptr) {
+                        pool_block* last = m_lists[index].head;
+                        while (last->next != nullptr) {
+                            last = last->next;
+                        }
+
+                        pool_central::instance().release(index, m_lists[index].head, last);
+                    }
+                }
+            }
+
+            [[nodiscard]] void* allocate(std::size_t index) {
+                free_list& list = m_lists[index];
+
+                if (list.head == nullptr) {
+                    list.head = pool_central::instance().acquire(index);
+                    list.count = 0;
+                    for (pool_block* block = list.head; block != nullptr; block = block->next) {
+                        ++list.count;
+                    }
+                }
+
+                pool_block* const block = list.head;
+                list.head = block->next;
+                --list.count;
+                return block;
+            }
+
+            void deallocate(std::size_t index, void* ptr) noexcept {
+                free_list& list = m_lists[index];
+
+                list.head = ::new (ptr) pool_block{ list.head };
+                if (++list.count <= 2 * pool_size_classes::batch) {
+                    return;
+                }
+
+                pool_block* const first = list.head;
+                pool_block* last = first;
+                for (std::size_t i = 1; i < pool_size_classes::batch; ++i) {
+                    last = last->next;
+                }
+
+                list.head = last->next;
+                list.count -= pool_size_classes::batch;
+                pool_central::instance().release(index, first, last);
+            }
+
+        private:
+            struct free_list {
+                pool_block* head{ nullptr };
+                std::size_t count{ 0 };
+            };
+
+            free_list m_lists[pool_size_classes::count]{};
+
+        };
+
+        inline thread_local pool_cache this_pool_cache{};
+    }
+
+    // Stateless allocator serving small allocations from power of two size classes cached per thread, allocations
+    // that are larger or over-aligned go to the global operator new. All instances compare equal.
+    template<typename T>
+    class pool_allocator {
+    public:
+        using value_type = T;
+
+        constexpr pool_allocator() noexcept = default;
+
+        template<typename U>
+        constexpr pool_allocator(const pool_allocator<U>&) noexcept {}
+
+        [[nodiscard]] T* allocate(std::size_t count) {
+            const std::size_t size = count * sizeof(T);
+
+            if (!is_pooled(size)) {
+                return static_cast<T*>(::operator new(size, std::align_val_t{ alignof(T) }));
+            }
+
+            return static_cast<T*>(details::this_pool_cache.allocate(details::pool_size_classes::index(size)));
+        }
+
+        void deallocate(T* ptr, std::size_t count) noexcept {
+            const std::size_t size = count * sizeof(T);
+
+            if (!is_pooled(size)) {
+                ::operator delete(ptr, size, std::align_val_t{ alignof(T) });
+                return;
+            }
+
+            details::this_pool_cache.deallocate(details::pool_size_classes::index(size), ptr);
+        }
+
+        template<typename U>
+        [[nodiscard]] friend constexpr bool operator==(const pool_allocator&, const pool_allocator<U>&) noexcept {
+            return true;
+        }
+
+    private:
+        [[nodiscard]] static constexpr bool is_pooled(std::size_t size) noexcept {
+            return alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ && size <= details::pool_size_classes::max_size;
+        }
+
+    };
+}
+
+#endif // !EXEC_POOL_ALLOCATOR_HPP
\ No newline at end of file
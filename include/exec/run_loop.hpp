@@ -6,47 +6,79 @@
 #include "exec/env.hpp"
 #include "exec/operation_state.hpp"
 #include "exec/receiver.hpp"
+#include "exec/run_loop_metrics.hpp"
 #include "exec/scheduler.hpp"
 #include "exec/sender.hpp"
 #include "exec/stop_token.hpp"
 
+#include "exec/details/atomic_intrusive_queue.hpp"
+#include "exec/details/intrusive_queue.hpp"
+#include "exec/details/intrusive_task.hpp"
+#include "exec/details/spin_lock_hint.hpp"
+
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <exception>
 #include <mutex>
-#include <queue>
+#include <stdexcept>
+#include <thread>
 #include <utility>
 
 namespace exec {
-    class run_loop {
-        struct operation_state_base {
-            virtual ~operation_state_base() noexcept = default;
-
-            virtual void run() noexcept = 0;
+    struct run_loop_policy {
+        enum class drain_mode : std::uint8_t {
+            single,
+            batch
         };
 
+        // single: pop one task per iteration, sharing the queue fairly between threads calling run().
+        // batch: take every pending task at once and run them locally without touching the loop mutex.
+        drain_mode drain{ drain_mode::single };
+
+        // Upper bound of the adaptive spin performed on an empty queue before parking, 0 disables spinning.
+        std::uint32_t max_spin{ 0 };
+
+        // Counters updated by the loop when set, left null a loop only pays for the null checks.
+        run_loop_metrics* metrics{ nullptr };
+    };
+
+    class run_loop {
         template<receiver ReceiverT>
-        struct operation_state : operation_state_base {
+        struct operation_state : details::intrusive_task {
             using operation_state_concept = operation_state_t;
 
             explicit operation_state(run_loop* loop, receiver auto&& receiver) noexcept :
+                intrusive_task(&operation_state::execute),
                 loop(loop),
                 receiver(std::forward<decltype(receiver)>(receiver)) {}
 
             run_loop* loop;
             ReceiverT receiver;
+            std::int64_t enqueued_ns{ 0 };
+
+            static void execute(intrusive_task* task) noexcept {
+                auto& self = *static_cast<operation_state*>(task);
 
-            void run() noexcept override {
-                if (get_stop_token(exec::get_env(receiver)).stop_requested()) {
-                    set_stopped(std::move(receiver));
+                if (run_loop_metrics* metrics = self.loop->m_policy.metrics) {
+                    metrics->record_execute(run_loop_metrics::now() - self.enqueued_ns);
+                }
+
+                if (get_stop_token(exec::get_env(self.receiver)).stop_requested()) {
+                    set_stopped(std::move(self.receiver));
                 }
                 else {
-                    set_value(std::move(receiver));
+                    set_value(std::move(self.receiver));
                 }
             }
 
             void start() noexcept {
                 try {
+                    if (loop->m_policy.metrics != nullptr) {
+                        enqueued_ns = run_loop_metrics::now();
+                    }
+
                     loop->push_back(this);
                 }
                 catch (...) {
@@ -102,20 +134,24 @@ namespace exec {
         };
 
     public:
-        run_loop() noexcept : m_finished(false) {}
+        run_loop() noexcept = default;
+
+        explicit run_loop(run_loop_policy policy) noexcept : m_policy(policy) {}
 
         run_loop(run_loop&&) = delete;
 
         ~run_loop() noexcept {
-            size_t task_count{};
-            bool stopped{};
+            while (m_pushers.load(std::memory_order_acquire) != 0) {
+                EXEC_SPIN_LOCK_HINT();
+            }
+
+            bool pending{};
             {
                 std::scoped_lock lock(m_mutex);
-                task_count = m_queue.size();
-                stopped = m_finished;
+                pending = !m_tasks.empty() || !m_queue.empty();
             }
 
-            if (task_count > 0 || !stopped) {
+            if (pending || !m_finished.load(std::memory_order_acquire)) {
                 std::terminate();
             }
         }
@@ -125,49 +161,174 @@ namespace exec {
         }
 
         void run() {
-            while (auto* task = pop_front()) {
-                task->run();
+            std::uint32_t spin = m_policy.max_spin;
+
+            if (m_policy.drain == run_loop_policy::drain_mode::batch) {
+                for (auto batch = pop_batch(spin); !batch.empty(); batch = pop_batch(spin)) {
+                    while (auto* task = batch.pop_front()) {
+                        task->execute();
+                    }
+                }
+            }
+            else {
+                while (auto* task = pop_front(spin)) {
+                    task->execute();
+                }
             }
         }
 
+        // Runners may observe m_finished without the lock, as pop_batch() and spin_for_work() do, and return while
+        // the notification below is still running. It is ~run_loop taking m_mutex that keeps the loop alive until
+        // finish() unlocks, not the notification being made under the lock.
         void finish() noexcept {
-            {
-                std::scoped_lock lock(m_mutex);
-                m_finished = true;
-            }
+            std::scoped_lock lock(m_mutex);
+            m_finished.store(true, std::memory_order_seq_cst);
             m_cv.notify_all();
         }
 
     private:
-        void push_back(operation_state_base* task) {
-            {
+        // A push registers itself before checking m_finished and deregisters once it is done with the loop. Either
+        // the check sees finish(), or a runner that sees finish() also sees the push in flight and waits for it in
+        // drained(), so a task can neither be stranded in a finished loop nor woken into a destroyed one.
+        void push_back(details::intrusive_task* task) {
+            m_pushers.fetch_add(1, std::memory_order_seq_cst);
+
+            if (m_finished.load(std::memory_order_seq_cst)) {
+                m_pushers.fetch_sub(1, std::memory_order_release);
+                throw std::runtime_error("Invalid operation on finished run loop.");
+            }
+
+            if (m_policy.metrics != nullptr) {
+                m_policy.metrics->record_enqueue();
+            }
+
+            m_queue.push(task);
+
+            if (m_waiters.load(std::memory_order_seq_cst) > 0) {
                 std::scoped_lock lock(m_mutex);
-                if (m_finished) {
-                    throw std::runtime_error("Invalid operation on finished run loop.");
+                m_cv.notify_one();
+            }
+
+            m_pushers.fetch_sub(1, std::memory_order_release);
+        }
+
+        // Called once m_finished has been observed. The pushers are read before the queue, a push that had
+        // deregistered is then visible in it.
+        [[nodiscard]] bool drained() const noexcept {
+            return m_pushers.load(std::memory_order_seq_cst) == 0 && m_queue.empty();
+        }
+
+        details::intrusive_task* pop_front(std::uint32_t& spin) {
+            std::unique_lock lock(m_mutex);
+
+            while (true) {
+                if (auto* task = m_tasks.pop_front()) {
+                    return task;
+                }
+
+                m_tasks = m_queue.pop_all();
+                if (!m_tasks.empty()) {
+                    continue;
+                }
+
+                if (m_finished.load(std::memory_order_seq_cst)) {
+                    if (drained()) {
+                        return nullptr;
+                    }
+
+                    // A push in flight may need the mutex to notify.
+                    if (m_queue.empty()) {
+                        lock.unlock();
+                        std::this_thread::yield();
+                        lock.lock();
+                    }
+
+                    continue;
                 }
 
-                m_queue.push(task);
+                if (spin > 0) {
+                    lock.unlock();
+                    spin_for_work(spin);
+                    lock.lock();
+                }
+                else {
+                    park(lock);
+                    spin = std::min<std::uint32_t>(m_policy.max_spin, 1);
+                }
             }
-            m_cv.notify_one();
         }
 
-        operation_state_base* pop_front() {
-            std::unique_lock lock(m_mutex);
+        details::intrusive_queue<details::intrusive_task> pop_batch(std::uint32_t& spin) {
+            while (true) {
+                auto batch = m_queue.pop_all();
+                if (!batch.empty()) {
+                    return batch;
+                }
 
-            m_cv.wait(lock, [this]() -> bool { return m_finished || !m_queue.empty(); });
-            if (m_finished && m_queue.empty()) return nullptr;
+                if (m_finished.load(std::memory_order_seq_cst)) {
+                    if (drained()) {
+                        return {};
+                    }
 
-            auto* task = m_queue.front();
-            m_queue.pop();
+                    if (m_queue.empty()) {
+                        std::this_thread::yield();
+                    }
 
-            return task;
+                    continue;
+                }
+
+                if (spin > 0) {
+                    spin_for_work(spin);
+                }
+                else {
+                    std::unique_lock lock(m_mutex);
+                    park(lock);
+                    spin = std::min<std::uint32_t>(m_policy.max_spin, 1);
+                }
+            }
         }
 
-        mutable std::mutex m_mutex;
+        // Doubles the budget when spinning finds work and halves it when it does not, so a loop fed in bursts
+        // keeps spinning while a mostly idle one quickly falls back to parking. Waking from a park restarts at 1.
+        void spin_for_work(std::uint32_t& spin) noexcept {
+            for (std::uint32_t i = 0; i < spin; ++i) {
+                if (!m_queue.empty() || m_finished.load(std::memory_order_relaxed)) {
+                    spin = std::min(m_policy.max_spin, spin * 2);
+                    return;
+                }
+
+                EXEC_SPIN_LOCK_HINT();
+            }
+
+            spin /= 2;
+        }
+
+        void park(std::unique_lock<std::mutex>& lock) {
+            const std::int64_t parked_ns = m_policy.metrics != nullptr ? run_loop_metrics::now() : 0;
+
+            m_waiters.fetch_add(1, std::memory_order_seq_cst);
+            m_cv.wait(lock, [this]() noexcept -> bool {
+                return m_finished.load(std::memory_order_relaxed) || !m_queue.empty();
+            });
+            m_waiters.fetch_sub(1, std::memory_order_relaxed);
+
+            if (m_policy.metrics != nullptr) {
+                m_policy.metrics->record_idle(run_loop_metrics::now() - parked_ns);
+            }
+        }
+
+        run_loop_policy m_policy{};
+
+        // The queue head, the in-flight push count and the flags producers read are each on a line of their own, so
+        // that a push_back() and a runner draining the queue do not contend on anything but the queue head itself.
+        alignas(64) details::atomic_intrusive_queue<details::intrusive_task> m_queue;
+        alignas(64) std::atomic_size_t m_pushers{ 0 };
+        alignas(64) std::atomic_size_t m_waiters{ 0 };
+        std::atomic_bool m_finished{ false };
 
-        bool m_finished;
+        alignas(64) mutable std::mutex m_mutex;
         std::condition_variable m_cv;
-        std::queue<operation_state_base*> m_queue;
+        details::intrusive_queue<details::intrusive_task> m_tasks;
 
     };
 }
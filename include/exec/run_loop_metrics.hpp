@@ -0,0 +1,193 @@
+#ifndef EXEC_RUN_LOOP_METRICS_HPP
+#define EXEC_RUN_LOOP_METRICS_HPP
+
+#include "exec/details/thread_index.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace exec {
+    // Log-linear histogram of latencies in nanoseconds, in the style of HDR histograms: every power of two is split
+    // into 8 equal buckets, so a recorded value is known to within 12.5%. Values from 2^48ns on share the last bucket.
+    class latency_histogram {
+    public:
+        static constexpr std::size_t sub_bucket_bits = 3;
+        static constexpr std::size_t sub_bucket_count = std::size_t{ 1 } << sub_bucket_bits;
+        static constexpr std::size_t max_exponent = 47;
+        static constexpr std::size_t bucket_count = (max_exponent - sub_bucket_bits + 2) * sub_bucket_count;
+
+        [[nodiscard]] static constexpr std::size_t bucket_of(std::uint64_t value) noexcept {
+            if (value < sub_bucket_count) {
+                return static_cast<std::size_t>(value);
+            }
+
+            const std::size_t exponent = static_cast<std::size_t>(std::bit_width(value)) - 1;
+            if (exponent > max_exponent) {
+                return bucket_count - 1;
+            }
+
+            return (exponent - sub_bucket_bits + 1) * sub_bucket_count +
+                   static_cast<std::size_t>((value >> (exponent - sub_bucket_bits)) & (sub_bucket_count - 1));
+        }
+
+        [[nodiscard]] static constexpr std::uint64_t lower_bound(std::size_t bucket) noexcept {
+            if (bucket < sub_bucket_count) {
+                return bucket;
+            }
+
+            const std::size_t exponent = bucket / sub_bucket_count + sub_bucket_bits - 1;
+            return (sub_bucket_count + bucket % sub_bucket_count) << (exponent - sub_bucket_bits);
+        }
+
+        [[nodiscard]] static constexpr std::uint64_t upper_bound(std::size_t bucket) noexcept {
+            return bucket + 1 < bucket_count ? lower_bound(bucket + 1) - 1 : std::numeric_limits<std::uint64_t>::max();
+        }
+
+        [[nodiscard]] std::uint64_t count() const noexcept {
+            return m_count;
+        }
+
+        [[nodiscard]] std::chrono::nanoseconds mean() const noexcept {
+            return std::chrono::nanoseconds(m_count > 0 ? m_sum / m_count : 0);
+        }
+
+        // Upper bound of the bucket holding the value at `quantile`, between 0 and 1.
+        [[nodiscard]] std::chrono::nanoseconds percentile(double quantile) const noexcept {
+            if (m_count == 0) {
+                return std::chrono::nanoseconds(0);
+            }
+
+            const auto rank = std::max<std::uint64_t>(
+                1,
+                static_cast<std::uint64_t>(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(m_count) + 0.5));
+
+            std::uint64_t seen = 0;
+            for (std::size_t bucket = 0; bucket < bucket_count; ++bucket) {
+                seen += m_counts[bucket];
+                if (seen >= rank) {
+                    return std::chrono::nanoseconds(
+                        std::min(upper_bound(bucket), std::uint64_t{ std::numeric_limits<std::int64_t>::max() }));
+                }
+            }
+
+            return std::chrono::nanoseconds(std::numeric_limits<std::int64_t>::max());
+        }
+
+        [[nodiscard]] const std::array<std::uint64_t, bucket_count>& buckets() const noexcept {
+            return m_counts;
+        }
+
+    private:
+        friend class run_loop_metrics;
+
+        std::array<std::uint64_t, bucket_count> m_counts{};
+        std::uint64_t m_count{ 0 };
+        std::uint64_t m_sum{ 0 };
+
+    };
+
+    // Counters of a run_loop, or of every loop sharing it through run_loop_policy::metrics. Updates are relaxed
+    // increments on a cache line sized shard picked by the calling thread's index, read() sums the shards, so a
+    // snapshot taken while the loop runs is consistent per counter but not across them.
+    class run_loop_metrics {
+        struct alignas(64) shard {
+            std::atomic_uint64_t enqueued{ 0 };
+            std::atomic_uint64_t executed{ 0 };
+            std::atomic_uint64_t parks{ 0 };
+            std::atomic_uint64_t idle_ns{ 0 };
+            std::atomic_uint64_t wait_ns{ 0 };
+            std::array<std::atomic_uint64_t, latency_histogram::bucket_count> wait_buckets{};
+        };
+
+    public:
+        struct snapshot {
+            std::uint64_t enqueued;
+            std::uint64_t executed;
+            std::uint64_t parks;
+            std::chrono::nanoseconds idle_time;
+
+            // Time from start() of a schedule operation to its execution by run().
+            latency_histogram wait_time;
+
+            [[nodiscard]] std::uint64_t queue_depth() const noexcept {
+                return enqueued > executed ? enqueued - executed : 0;
+            }
+        };
+
+        run_loop_metrics() :
+            m_shard_count{ std::max(std::thread::hardware_concurrency(), 1u) },
+            m_shards{ std::make_unique<shard[]>(m_shard_count) } {}
+
+        run_loop_metrics(run_loop_metrics&&) = delete;
+
+        [[nodiscard]] snapshot read() const noexcept {
+            snapshot result{};
+            std::uint64_t idle_ns = 0;
+
+            for (std::size_t i = 0; i < m_shard_count; ++i) {
+                const shard& current = m_shards[i];
+
+                result.enqueued += current.enqueued.load(std::memory_order_relaxed);
+                result.executed += current.executed.load(std::memory_order_relaxed);
+                result.parks += current.parks.load(std::memory_order_relaxed);
+                idle_ns += current.idle_ns.load(std::memory_order_relaxed);
+                result.wait_time.m_sum += current.wait_ns.load(std::memory_order_relaxed);
+
+                for (std::size_t bucket = 0; bucket < latency_histogram::bucket_count; ++bucket) {
+                    const std::uint64_t count = current.wait_buckets[bucket].load(std::memory_order_relaxed);
+                    result.wait_time.m_counts[bucket] += count;
+                    result.wait_time.m_count += count;
+                }
+            }
+
+            result.idle_time = std::chrono::nanoseconds(idle_ns);
+
+            return result;
+        }
+
+        [[nodiscard]] static std::int64_t now() noexcept {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        void record_enqueue() noexcept {
+            this_shard().enqueued.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void record_execute(std::int64_t wait_ns) noexcept {
+            const auto wait = static_cast<std::uint64_t>(std::max<std::int64_t>(wait_ns, 0));
+            shard& current = this_shard();
+
+            current.executed.fetch_add(1, std::memory_order_relaxed);
+            current.wait_ns.fetch_add(wait, std::memory_order_relaxed);
+            current.wait_buckets[latency_histogram::bucket_of(wait)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void record_idle(std::int64_t idle_ns) noexcept {
+            shard& current = this_shard();
+
+            current.parks.fetch_add(1, std::memory_order_relaxed);
+            current.idle_ns.fetch_add(static_cast<std::uint64_t>(std::max<std::int64_t>(idle_ns, 0)),
+                                      std::memory_order_relaxed);
+        }
+
+    private:
+        [[nodiscard]] shard& this_shard() noexcept {
+            return m_shards[details::thread_index() % m_shard_count];
+        }
+
+        std::size_t m_shard_count;
+        std::unique_ptr<shard[]> m_shards;
+
+    };
+}
+
+#endif // !EXEC_RUN_LOOP_METRICS_HPP
\ No newline at end of file
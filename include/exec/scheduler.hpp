@@ -47,6 +47,7 @@ namespace exec {
     template<typename TagT>
     struct get_completion_scheduler_t {
         template<typename EnvT>
+        requires requires(const EnvT& env, get_completion_scheduler_t tag) { env.query(tag); }
         [[nodiscard]] constexpr decltype(auto) operator()(const EnvT& env) const noexcept {
             return env.query(*this);
         }
@@ -78,15 +78,20 @@ namespace exec {
     struct spawn_t {
         template<sender SenderT, scope_token TokenT, typename EnvT = empty_env>
         void operator()(SenderT&& sender, TokenT token, EnvT env = {}) const {
+            // An allocator from the env wins over the sender's, scopes may provide a default through their token.
             auto get_alloc = [&] noexcept {
                 if constexpr (requires { env.query(get_allocator_t{}); }) {
                     return get_allocator(env);
                 }
-                if constexpr (requires { sender.query(get_allocator_t{}); }) {
+                else if constexpr (requires { sender.query(get_allocator_t{}); }) {
                     return get_allocator(sender);
                 }
-
-                return std::allocator<void>{};
+                else if constexpr (requires { token.query(get_allocator_t{}); }) {
+                    return get_allocator(token);
+                }
+                else {
+                    return std::allocator<void>{};
+                }
             };
 
             using src_alloc_t = std::remove_cvref_t<decltype(get_alloc())>;
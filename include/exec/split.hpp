@@ -0,0 +1,37 @@
+#ifndef EXEC_SPLIT_HPP
+#define EXEC_SPLIT_HPP
+
+#include "exec/sender.hpp"
+#include "exec/sender_adapter_closure.hpp"
+
+#include "exec/details/basic_closure.hpp"
+#include "exec/details/basic_sender.hpp"
+#include "exec/details/product_type.hpp"
+#include "exec/details/shared_state.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace exec {
+    struct split_t;
+
+    template<>
+    struct details::impls_for<split_t> : shared_impls {};
+
+    struct split_t {
+        template<sender SenderT>
+        [[nodiscard]] auto operator()(SenderT&& input) const {
+            using state_t = details::shared_state<std::decay_t<SenderT>>;
+
+            return details::make_sender(
+                *this, details::shared_handle<std::decay_t<SenderT>>{ new state_t(std::forward<SenderT>(input)) });
+        }
+
+        [[nodiscard]] constexpr auto operator()() const noexcept {
+            return details::basic_closure{ sender_adapter_closure<split_t>{}, details::product_type{} };
+        }
+    };
+    inline constexpr split_t split{};
+}
+
+#endif // !EXEC_SPLIT_HPP
\ No newline at end of file
@@ -0,0 +1,580 @@
+#ifndef EXEC_STATIC_THREAD_POOL_HPP
+#define EXEC_STATIC_THREAD_POOL_HPP
+
+#include "exec/bulk.hpp"
+#include "exec/completions.hpp"
+#include "exec/completion_signatures.hpp"
+#include "exec/env.hpp"
+#include "exec/forward_progress_guarantee.hpp"
+#include "exec/operation_state.hpp"
+#include "exec/receiver.hpp"
+#include "exec/scheduler.hpp"
+#include "exec/sender.hpp"
+#include "exec/stop_token.hpp"
+
+#include "exec/details/basic_sender.hpp"
+#include "exec/details/decayed_tuple.hpp"
+#include "exec/details/gather_signatures.hpp"
+#include "exec/details/intrusive_queue.hpp"
+#include "exec/details/intrusive_task.hpp"
+#include "exec/details/meta_add.hpp"
+#include "exec/details/meta_merge.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace exec::details {
+    struct pool_bulk_t {};
+}
+
+namespace exec {
+    class static_thread_pool {
+        friend struct details::impls_for<details::pool_bulk_t>;
+
+        using task_base = details::intrusive_task;
+
+        class alignas(64) worker_queue {
+        public:
+            [[nodiscard]] std::optional<bool> try_push(task_base* task) {
+                std::unique_lock lock(m_mutex, std::try_to_lock);
+                if (!lock.owns_lock()) {
+                    return std::nullopt;
+                }
+
+                return push_locked(task);
+            }
+
+            bool push(task_base* task) {
+                std::scoped_lock lock(m_mutex);
+                return push_locked(task);
+            }
+
+            [[nodiscard]] task_base* try_pop() noexcept {
+                std::unique_lock lock(m_mutex, std::try_to_lock);
+                if (!lock.owns_lock()) {
+                    return nullptr;
+                }
+
+                return m_tasks.pop_front();
+            }
+
+            void prepare_wait() noexcept {
+                std::scoped_lock lock(m_mutex);
+                m_sleeping = true;
+                m_wakeup = false;
+            }
+
+            void cancel_wait() noexcept {
+                std::scoped_lock lock(m_mutex);
+                m_sleeping = false;
+                m_wakeup = false;
+            }
+
+            [[nodiscard]] task_base* wait() noexcept {
+                std::unique_lock lock(m_mutex);
+                m_cv.wait(lock, [this]() noexcept -> bool { return m_finished || m_wakeup || !m_tasks.empty(); });
+
+                m_sleeping = false;
+                m_wakeup = false;
+
+                return m_tasks.pop_front();
+            }
+
+            bool wake() noexcept {
+                std::scoped_lock lock(m_mutex);
+                if (!m_sleeping || m_wakeup) {
+                    return false;
+                }
+
+                m_wakeup = true;
+                m_cv.notify_one();
+
+                return true;
+            }
+
+            void finish() noexcept {
+                {
+                    std::scoped_lock lock(m_mutex);
+                    m_finished = true;
+                }
+                m_cv.notify_all();
+            }
+
+            [[nodiscard]] bool finished() const noexcept {
+                std::scoped_lock lock(m_mutex);
+                return m_finished && m_tasks.empty();
+            }
+
+        private:
+            bool push_locked(task_base* task) {
+                if (m_finished) {
+                    throw std::runtime_error("Invalid operation on finished thread pool.");
+                }
+
+                m_tasks.push_back(task);
+
+                if (m_sleeping && !m_wakeup) {
+                    m_wakeup = true;
+                    m_cv.notify_one();
+
+                    return true;
+                }
+
+                return false;
+            }
+
+            mutable std::mutex m_mutex;
+            std::condition_variable m_cv;
+            details::intrusive_queue<task_base> m_tasks;
+
+            bool m_sleeping{ false };
+            bool m_wakeup{ false };
+            bool m_finished{ false };
+
+        };
+
+        template<receiver ReceiverT>
+        struct operation_state : task_base {
+            using operation_state_concept = operation_state_t;
+
+            explicit operation_state(static_thread_pool* pool, receiver auto&& receiver) noexcept :
+                task_base(&operation_state::execute),
+                pool(pool),
+                receiver(std::forward<decltype(receiver)>(receiver)) {}
+
+            static_thread_pool* pool;
+            ReceiverT receiver;
+
+            static void execute(task_base* task) noexcept {
+                auto& self = *static_cast<operation_state*>(task);
+
+                if (get_stop_token(exec::get_env(self.receiver)).stop_requested()) {
+                    set_stopped(std::move(self.receiver));
+                }
+                else {
+                    set_value(std::move(self.receiver));
+                }
+            }
+
+            void start() noexcept {
+                try {
+                    pool->enqueue(this);
+                }
+                catch (...) {
+                    set_error(std::move(receiver), std::current_exception());
+                }
+            }
+        };
+
+        template<typename ShapeT, typename InvocableT>
+        struct bulk_data : details::bulk_data<ShapeT, InvocableT> {
+            static_thread_pool* pool;
+        };
+
+        struct scheduler {
+            struct sender {
+                struct env {
+                    static_thread_pool* pool;
+
+                    [[nodiscard]] constexpr auto query(get_completion_scheduler_t<set_value_t>) const noexcept {
+                        return pool->get_scheduler();
+                    }
+
+                    [[nodiscard]] constexpr auto query(get_completion_scheduler_t<set_stopped_t>) const noexcept {
+                        return pool->get_scheduler();
+                    }
+                };
+
+                using sender_concept = sender_t;
+
+                using completion_signatures =
+                    completion_signatures<set_value_t(), set_error_t(std::exception_ptr), set_stopped_t()>;
+
+                static_thread_pool* pool;
+
+                [[nodiscard]] auto get_env() const noexcept {
+                    return env{ pool };
+                }
+
+                constexpr auto connect(receiver auto&& rcvr) {
+                    return operation_state<std::decay_t<decltype(rcvr)>>(pool, std::forward<decltype(rcvr)>(rcvr));
+                }
+            };
+
+            using scheduler_concept = scheduler_t;
+
+            static_thread_pool* pool;
+
+            [[nodiscard]] constexpr sender schedule() const noexcept {
+                return sender{ pool };
+            }
+
+            template<exec::sender SenderT, std::integral ShapeT, typename InvocableT>
+            [[nodiscard]] constexpr auto bulk(SenderT&& input, ShapeT shape, InvocableT&& invocable) const {
+                return details::make_sender(
+                    details::pool_bulk_t{},
+                    bulk_data<ShapeT, std::decay_t<InvocableT>>{ { shape, std::forward<InvocableT>(invocable) }, pool },
+                    std::forward<SenderT>(input));
+            }
+
+            [[nodiscard]] static constexpr forward_progress_guarantee query(get_forward_progress_guarantee_t) noexcept {
+                return forward_progress_guarantee::parallel;
+            }
+
+        private:
+            [[nodiscard]]
+            friend constexpr bool operator==(const scheduler& left, const scheduler& right) noexcept {
+                return left.pool == right.pool;
+            }
+
+        };
+
+        struct worker_info {
+            static_thread_pool* pool;
+            std::size_t index;
+        };
+
+    public:
+        explicit static_thread_pool(std::uint32_t thread_count = std::thread::hardware_concurrency()) :
+            m_thread_count(std::max<std::uint32_t>(thread_count, 1)),
+            m_queues(std::make_unique<worker_queue[]>(m_thread_count)),
+            m_sleepers(std::make_unique<std::atomic_uint64_t[]>(sleeper_word_count()))
+        {
+            m_threads.reserve(m_thread_count);
+            for (std::size_t i = 0; i < m_thread_count; ++i) {
+                m_threads.emplace_back([this, i] { run(i); });
+            }
+        }
+
+        static_thread_pool(static_thread_pool&&) = delete;
+
+        ~static_thread_pool() noexcept {
+            request_stop();
+
+            for (auto& thread : m_threads) {
+                thread.join();
+            }
+        }
+
+        [[nodiscard]] constexpr scheduler get_scheduler() noexcept {
+            return scheduler{ this };
+        }
+
+        [[nodiscard]] std::uint32_t available_parallelism() const noexcept {
+            return m_thread_count;
+        }
+
+        void request_stop() noexcept {
+            for (std::size_t i = 0; i < m_thread_count; ++i) {
+                m_queues[i].finish();
+            }
+        }
+
+    private:
+        void enqueue(task_base* task) {
+            const auto& worker = this_worker;
+            const std::size_t start = worker.pool == this ?
+                worker.index :
+                m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_thread_count;
+
+            std::size_t target = start;
+            std::optional<bool> woke{};
+            for (std::size_t i = 0; i < m_thread_count && !woke.has_value(); ++i) {
+                target = (start + i) % m_thread_count;
+                woke = m_queues[target].try_push(task);
+            }
+
+            if (!woke.has_value()) {
+                target = start;
+                woke = m_queues[target].push(task);
+            }
+
+            if (!*woke && m_idle.load(std::memory_order_seq_cst) > 0) {
+                wake_one(target);
+            }
+        }
+
+        [[nodiscard]] std::size_t sleeper_word_count() const noexcept {
+            return (m_thread_count + 63) / 64;
+        }
+
+        void mark_sleeping(std::size_t index) noexcept {
+            m_sleepers[index / 64].fetch_or(std::uint64_t{ 1 } << (index % 64), std::memory_order_seq_cst);
+        }
+
+        bool clear_sleeping(std::size_t index) noexcept {
+            const std::uint64_t bit = std::uint64_t{ 1 } << (index % 64);
+            return (m_sleepers[index / 64].fetch_and(~bit, std::memory_order_acq_rel) & bit) != 0;
+        }
+
+        // Claims workers from the sleeper bitmap, starting from the word of `start`, and only locks the queue of a
+        // claimed one. A claimed worker that is no longer waiting does not count and the search goes on.
+        void wake_one(std::size_t start) noexcept {
+            const std::size_t words = sleeper_word_count();
+            for (std::size_t i = 0; i < words; ++i) {
+                const std::size_t word = (start / 64 + i) % words;
+
+                std::uint64_t sleeping = m_sleepers[word].load(std::memory_order_acquire);
+                while (sleeping != 0) {
+                    const std::size_t index = word * 64 + static_cast<std::size_t>(std::countr_zero(sleeping));
+                    sleeping &= sleeping - 1;
+
+                    if (clear_sleeping(index) && m_queues[index].wake()) {
+                        return;
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] task_base* try_steal(std::size_t index) noexcept {
+            for (std::size_t i = 0; i < m_thread_count; ++i) {
+                if (auto* task = m_queues[(index + i) % m_thread_count].try_pop()) {
+                    return task;
+                }
+            }
+
+            return nullptr;
+        }
+
+        // A task pushed to a queue is always run by the queue's worker, the push wakes it if it sleeps and wait()
+        // does not sleep on a non-empty queue. The steal pass before sleeping is only there to pick up work sooner,
+        // so it skips contended queues rather than lock every queue of the pool on each idle transition.
+        [[nodiscard]] task_base* park(std::size_t index) noexcept {
+            auto& queue = m_queues[index];
+
+            queue.prepare_wait();
+            mark_sleeping(index);
+            m_idle.fetch_add(1, std::memory_order_seq_cst);
+
+            auto* task = try_steal(index);
+            if (task != nullptr) {
+                queue.cancel_wait();
+            }
+            else {
+                task = queue.wait();
+            }
+
+            clear_sleeping(index);
+            m_idle.fetch_sub(1, std::memory_order_relaxed);
+
+            return task;
+        }
+
+        void run(std::size_t index) noexcept {
+            this_worker = worker_info{ this, index };
+
+            while (true) {
+                auto* task = try_steal(index);
+                if (task == nullptr) {
+                    task = park(index);
+                }
+
+                if (task != nullptr) {
+                    task->execute();
+                }
+                else if (m_queues[index].finished()) {
+                    break;
+                }
+            }
+
+            this_worker = worker_info{ nullptr, 0 };
+        }
+
+        static inline thread_local worker_info this_worker{ nullptr, 0 };
+
+        std::uint32_t m_thread_count;
+        std::unique_ptr<worker_queue[]> m_queues;
+        std::unique_ptr<std::atomic_uint64_t[]> m_sleepers;
+        std::vector<std::thread> m_threads;
+
+        alignas(64) std::atomic_size_t m_next_queue{ 0 };
+        alignas(64) std::atomic_size_t m_idle{ 0 };
+
+    };
+
+    // Splits the index space into one contiguous chunk per worker. The thread that completes the predecessor runs the
+    // first chunk itself, the last chunk to finish delivers the result.
+    template<>
+    struct details::impls_for<details::pool_bulk_t> : default_impls {
+        template<typename ShapeT, typename InvocableT, typename ReceiverT, typename ValuesT>
+        struct state {
+            struct chunk : intrusive_task {
+                chunk() noexcept : intrusive_task(&state::run_chunk) {}
+
+                state* self{ nullptr };
+                ShapeT begin{ 0 };
+                ShapeT end{ 0 };
+            };
+
+            explicit state(static_thread_pool* pool, ShapeT shape, InvocableT invocable, ReceiverT& receiver) :
+                pool(pool),
+                invocable(std::move(invocable)),
+                receiver(receiver)
+            {
+                if (shape <= 0) {
+                    return;
+                }
+
+                const auto count = static_cast<ShapeT>(
+                    std::min<std::size_t>(pool->available_parallelism(), static_cast<std::size_t>(shape)));
+                const ShapeT base = shape / count;
+                const ShapeT extra = shape % count;
+
+                chunks = std::make_unique<chunk[]>(static_cast<std::size_t>(count));
+                chunk_count = static_cast<std::size_t>(count);
+
+                ShapeT begin = 0;
+                for (ShapeT i = 0; i < count; ++i) {
+                    auto& current = chunks[static_cast<std::size_t>(i)];
+                    current.self = this;
+                    current.begin = begin;
+                    current.end = begin + base + (i < extra ? 1 : 0);
+                    begin = current.end;
+                }
+            }
+
+            state(state&&) = delete;
+
+            static_thread_pool* pool;
+            InvocableT invocable;
+            ReceiverT& receiver;
+
+            ValuesT values{};
+            std::unique_ptr<chunk[]> chunks{};
+            std::size_t chunk_count{ 0 };
+
+            std::atomic_size_t remaining{ 0 };
+            std::atomic_bool failed{ false };
+            std::exception_ptr error{};
+
+            void launch() noexcept {
+                if (chunk_count == 0) {
+                    deliver();
+                    return;
+                }
+
+                remaining.store(chunk_count, std::memory_order_relaxed);
+
+                for (std::size_t i = 1; i < chunk_count; ++i) {
+                    try {
+                        pool->enqueue(&chunks[i]);
+                    }
+                    catch (...) {
+                        chunks[i].execute();
+                    }
+                }
+
+                chunks[0].execute();
+            }
+
+            static void run_chunk(intrusive_task* task) noexcept {
+                auto& current = *static_cast<chunk*>(task);
+                auto& self = *current.self;
+
+                if (!self.failed.load(std::memory_order_relaxed)) {
+                    try {
+                        std::visit([&]<typename TupleT>(TupleT& tuple) {
+                            if constexpr (!std::is_same_v<TupleT, std::monostate>) {
+                                std::apply([&](auto&... args) {
+                                    for (ShapeT i = current.begin; i < current.end; ++i) {
+                                        std::invoke(self.invocable, i, args...);
+                                    }
+                                }, tuple);
+                            }
+                        }, self.values);
+                    }
+                    catch (...) {
+                        if (!self.failed.exchange(true, std::memory_order_relaxed)) {
+                            self.error = std::current_exception();
+                        }
+                    }
+                }
+
+                if (self.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    self.deliver();
+                }
+            }
+
+            void deliver() noexcept {
+                if (failed.load(std::memory_order_relaxed)) {
+                    exec::set_error(std::move(receiver), std::move(error));
+                    return;
+                }
+
+                std::visit([this]<typename TupleT>(TupleT& tuple) noexcept {
+                    if constexpr (!std::is_same_v<TupleT, std::monostate>) {
+                        std::apply([this](auto&... args) noexcept {
+                            exec::set_value(std::move(receiver), std::move(args)...);
+                        }, tuple);
+                    }
+                }, values);
+            }
+        };
+
+        static constexpr auto get_completion_signatures =
+            []<typename SenderT, typename EnvT>(SenderT&&, EnvT&&) noexcept {
+                using child_sender_t = decltype(std::forward_like<SenderT>(std::declval<child_of_t<SenderT, 0>>()));
+
+                return meta_merge_t<completion_signatures_of_t<child_sender_t, EnvT>,
+                                    completion_signatures<exec::set_error_t(std::exception_ptr)>>{};
+            };
+
+        static constexpr auto get_state =
+            []<typename SenderT, typename ReceiverT>(SenderT&& sender, ReceiverT& receiver) {
+                using child_completion_signatures_t =
+                    completion_signatures_of_t<child_of_t<SenderT, 0>, env_of_t<ReceiverT>>;
+                using values_t =
+                    meta_add_t<std::variant<std::monostate>,
+                               gather_signatures<exec::set_value_t,
+                                                 child_completion_signatures_t,
+                                                 decayed_tuple,
+                                                 std::variant>>;
+
+                auto&& data = get_data(std::forward<SenderT>(sender));
+                using data_t = std::remove_cvref_t<decltype(data)>;
+
+                return state<decltype(data_t::shape), decltype(data_t::invocable), ReceiverT, values_t>{
+                    data.pool,
+                    data.shape,
+                    std::forward_like<decltype(data)>(data.invocable),
+                    receiver
+                };
+            };
+
+        static constexpr auto complete =
+            []<typename StateT, typename ReceiverT, typename TagT, typename... ArgTs>
+                (auto, StateT& state, ReceiverT& receiver, TagT, ArgTs&&... args) noexcept -> void
+            {
+                if constexpr (std::is_same_v<TagT, exec::set_value_t>) {
+                    try {
+                        state.values.template emplace<decayed_tuple<ArgTs...>>(std::forward<ArgTs>(args)...);
+                    }
+                    catch (...) {
+                        exec::set_error(std::move(receiver), std::current_exception());
+                        return;
+                    }
+
+                    state.launch();
+                }
+                else {
+                    TagT{}(std::move(receiver), std::forward<ArgTs>(args)...);
+                }
+            };
+    };
+}
+
+#endif // !EXEC_STATIC_THREAD_POOL_HPP
\ No newline at end of file
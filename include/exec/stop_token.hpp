@@ -4,10 +4,15 @@
 #include "exec/forwarding_query.hpp"
 
 #include "exec/details/base_stop_callback.hpp"
+#include "exec/details/refcounted_stop_state.hpp"
+#include "exec/details/spin_lock_hint.hpp"
 #include "exec/details/stop_state.hpp"
 
+#include <atomic>
 #include <cassert>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <stop_token>
@@ -36,6 +41,8 @@ namespace exec {
     template<typename CallbackT>
     class stop_callback;
 
+    class inplace_stop_token;
+
     class stop_token {
     public:
         template<typename CallbackT>
@@ -43,7 +50,28 @@ namespace exec {
 
         stop_token() = default;
 
-        [[nodiscard]] bool operator==(const stop_token&) const = default;
+        stop_token(const stop_token& other) noexcept : m_state(other.m_state) {
+            if (m_state != nullptr) {
+                m_state->add_ref();
+            }
+        }
+
+        stop_token(stop_token&& other) noexcept : m_state(std::exchange(other.m_state, nullptr)) {}
+
+        stop_token& operator=(stop_token other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        ~stop_token() {
+            if (m_state != nullptr) {
+                m_state->release();
+            }
+        }
+
+        [[nodiscard]] bool operator==(const stop_token& other) const noexcept {
+            return m_state == other.m_state;
+        }
 
         [[nodiscard]] bool stop_requested() const noexcept {
             return m_state != nullptr && m_state->stop_requested();
@@ -53,6 +81,9 @@ namespace exec {
             return m_state != nullptr;
         }
 
+        // A token without ownership of the state, for uses that do not outlive this token.
+        [[nodiscard]] inplace_stop_token get_inplace_token() const noexcept;
+
         void swap(stop_token& other) noexcept {
             std::swap(m_state, other.m_state);
         }
@@ -63,26 +94,51 @@ namespace exec {
 
         friend class stop_source;
 
-        explicit stop_token(const std::shared_ptr<details::stop_state>& state) noexcept : m_state(state) {}
-
-        [[nodiscard]] const std::shared_ptr<details::stop_state>& get_state() const noexcept {
-            return m_state;
+        explicit stop_token(details::refcounted_stop_state* state) noexcept : m_state(state) {
+            if (m_state != nullptr) {
+                m_state->add_ref();
+            }
         }
 
-        std::shared_ptr<details::stop_state> m_state;
+        details::refcounted_stop_state* m_state{ nullptr };
 
     };
 
     class stop_source {
     public:
-        stop_source() : m_state(std::make_shared<details::stop_state>()) {}
+        stop_source() : m_state(details::refcounted_stop_state::make(std::allocator<std::byte>{})) {}
+
+        template<typename AllocT>
+        stop_source(std::allocator_arg_t, const AllocT& alloc) : m_state(details::refcounted_stop_state::make(alloc)) {}
 
         explicit stop_source(std::nostopstate_t) noexcept {}
 
+        stop_source(const stop_source& other) noexcept : m_state(other.m_state) {
+            if (m_state != nullptr) {
+                m_state->add_ref();
+            }
+        }
+
+        stop_source(stop_source&& other) noexcept : m_state(std::exchange(other.m_state, nullptr)) {}
+
+        stop_source& operator=(stop_source other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        ~stop_source() {
+            if (m_state != nullptr) {
+                m_state->release();
+            }
+        }
+
         [[nodiscard]] stop_token get_token() const noexcept {
             return stop_token{ m_state };
         }
 
+        // A token without ownership of the state, for uses that do not outlive this source.
+        [[nodiscard]] inplace_stop_token get_inplace_token() const noexcept;
+
         [[nodiscard]] static constexpr bool stop_possible() noexcept {
             return true;
         }
@@ -96,15 +152,15 @@ namespace exec {
         }
 
         void swap(stop_source& other) noexcept {
-            m_state.swap(other.m_state);
+            std::swap(m_state, other.m_state);
         }
 
-        [[nodiscard]] bool operator==(const stop_source&) const = default;
+        [[nodiscard]] bool operator==(const stop_source& other) const noexcept {
+            return m_state == other.m_state;
+        }
 
     private:
-        friend class stop_token;
-
-        std::shared_ptr<details::stop_state> m_state;
+        details::refcounted_stop_state* m_state{ nullptr };
     };
 
     template<typename CallbackT>
@@ -115,12 +171,12 @@ namespace exec {
         template<typename InitT>
         explicit stop_callback(stop_token token, InitT&& init)
             noexcept(std::is_nothrow_constructible_v<CallbackT, InitT>) :
-                m_callback(std::forward<InitT>(init)), m_state(token.get_state())
+                m_callback(std::forward<InitT>(init)), m_state(std::exchange(token.m_state, nullptr))
         {
             if (m_state != nullptr) {
                 if (!m_state->try_add_callback(this)) {
                     stop_callback::invoke();
-                    m_state.reset();
+                    std::exchange(m_state, nullptr)->release();
                 }
             }
         }
@@ -128,6 +184,7 @@ namespace exec {
         ~stop_callback() noexcept override {
             if (m_state != nullptr) {
                 m_state->remove_callback(this);
+                m_state->release();
             }
         }
 
@@ -143,7 +200,7 @@ namespace exec {
         }
 
         CallbackT m_callback;
-        std::shared_ptr<details::stop_state> m_state;
+        details::refcounted_stop_state* m_state;
 
     };
 
@@ -153,8 +210,6 @@ namespace exec {
     template<typename CallbackT>
     class inplace_stop_callback;
 
-    class inplace_stop_source;
-
     class inplace_stop_token {
     public:
         template<typename CallbackT>
@@ -164,14 +219,16 @@ namespace exec {
 
         [[nodiscard]] bool operator==(const inplace_stop_token&) const = default;
 
-        [[nodiscard]] bool stop_requested() const noexcept;
+        [[nodiscard]] bool stop_requested() const noexcept {
+            return m_state != nullptr && m_state->stop_requested();
+        }
 
         [[nodiscard]] bool stop_possible() const noexcept {
-            return m_src != nullptr;
+            return m_state != nullptr;
         }
 
         void swap(inplace_stop_token& other) noexcept {
-            std::swap(m_src, other.m_src);
+            std::swap(m_state, other.m_state);
         }
 
     private:
@@ -179,15 +236,28 @@ namespace exec {
         friend class inplace_stop_callback;
 
         friend class inplace_stop_source;
+        friend class stop_source;
+        friend class stop_token;
+        friend class linked_stop_source;
 
-        explicit inplace_stop_token(const inplace_stop_source* src) noexcept : m_src(src) {};
+        explicit inplace_stop_token(const details::stop_state* state) noexcept : m_state(state) {};
 
-        [[nodiscard]] const details::stop_state* get_state() const noexcept;
+        [[nodiscard]] const details::stop_state* get_state() const noexcept {
+            return m_state;
+        }
 
-        const inplace_stop_source* m_src{ nullptr };
+        const details::stop_state* m_state{ nullptr };
 
     };
 
+    inline inplace_stop_token stop_token::get_inplace_token() const noexcept {
+        return inplace_stop_token{ m_state };
+    }
+
+    inline inplace_stop_token stop_source::get_inplace_token() const noexcept {
+        return inplace_stop_token{ m_state };
+    }
+
     class inplace_stop_source {
     public:
         inplace_stop_source() noexcept = default;
@@ -201,7 +271,7 @@ namespace exec {
         inplace_stop_source& operator=(inplace_stop_source&&) = delete;
 
         [[nodiscard]] inplace_stop_token get_token() const noexcept {
-            return inplace_stop_token{ this };
+            return inplace_stop_token{ &m_state };
         }
 
         [[nodiscard]] static constexpr bool stop_possible() noexcept {
@@ -217,24 +287,10 @@ namespace exec {
         }
 
     private:
-        friend class inplace_stop_token;
-
         details::stop_state m_state;
 
     };
 
-    inline bool inplace_stop_token::stop_requested() const noexcept {
-        return m_src != nullptr && m_src->stop_requested();
-    }
-
-    inline const details::stop_state* inplace_stop_token::get_state() const noexcept {
-        if (m_src == nullptr) {
-            return nullptr;
-        }
-
-        return &m_src->m_state;
-    }
-
     template<typename CallbackT>
     class inplace_stop_callback : details::base_stop_callback {
     public:
@@ -278,6 +334,159 @@ namespace exec {
     template<typename CallbackT>
     inplace_stop_callback(inplace_stop_token, CallbackT) -> inplace_stop_callback<CallbackT>;
 
+    // An inplace_stop_source that is also stopped when its parent token is. It attaches to the parent with a single
+    // intrusive callback. A stop reaching a tree of linked sources is propagated breadth-first from one loop per
+    // thread, so deep or wide trees neither grow the stack nor register anything per level. Linked sources must be
+    // destroyed before the source of their parent token.
+    class linked_stop_source {
+    public:
+        linked_stop_source() noexcept = default;
+
+        explicit linked_stop_source(inplace_stop_token parent) noexcept : m_parent(parent.get_state()) {
+            if (m_parent != nullptr && !m_parent->try_add_callback(&m_node)) {
+                m_parent = nullptr;
+                m_state.try_request_stop();
+            }
+        }
+
+        ~linked_stop_source() noexcept {
+            if (m_parent != nullptr) {
+                m_parent->remove_callback(&m_node);
+            }
+
+            if (m_queued.load(std::memory_order_acquire) != Idle && !this_queue.unlink(this)) {
+                wait_processed();
+            }
+        }
+
+        linked_stop_source(const linked_stop_source&) = delete;
+        linked_stop_source& operator=(const linked_stop_source&) = delete;
+
+        linked_stop_source(linked_stop_source&&) = delete;
+        linked_stop_source& operator=(linked_stop_source&&) = delete;
+
+        [[nodiscard]] inplace_stop_token get_token() const noexcept {
+            return inplace_stop_token{ &m_state };
+        }
+
+        [[nodiscard]] static constexpr bool stop_possible() noexcept {
+            return true;
+        }
+
+        [[nodiscard]] bool stop_requested() const noexcept {
+            return m_state.stop_requested();
+        }
+
+        bool request_stop() noexcept {
+            if (this_queue.active) {
+                return m_state.try_request_stop();
+            }
+
+            this_queue.active = true;
+            const bool stopped = m_state.try_request_stop();
+            this_queue.drain();
+            this_queue.active = false;
+
+            return stopped;
+        }
+
+    private:
+        enum queue_state : std::uint8_t {
+            Idle,
+            Queued,
+            Processed
+        };
+
+        struct parent_node : details::base_stop_callback {
+            explicit parent_node(linked_stop_source* self) noexcept : self(self) {}
+
+            void invoke() noexcept override {
+                self->parent_stopped();
+            }
+
+            linked_stop_source* self;
+        };
+
+        // Linked sources whose parent stopped while this thread was already propagating a stop.
+        struct propagation_queue {
+            linked_stop_source* head{ nullptr };
+            linked_stop_source* tail{ nullptr };
+            bool active{ false };
+
+            void push(linked_stop_source* source) noexcept {
+                source->m_queued.store(Queued, std::memory_order_relaxed);
+                source->m_next = nullptr;
+
+                if (tail != nullptr) {
+                    tail->m_next = source;
+                }
+                else {
+                    head = source;
+                }
+                tail = source;
+            }
+
+            void drain() noexcept {
+                while (head != nullptr) {
+                    linked_stop_source* const source = std::exchange(head, head->m_next);
+                    if (head == nullptr) {
+                        tail = nullptr;
+                    }
+
+                    source->m_state.try_request_stop();
+                    source->m_queued.store(Processed, std::memory_order_release);
+                    source->m_queued.notify_all();
+                    source->m_queued.store(Idle, std::memory_order_release);
+                }
+            }
+
+            [[nodiscard]] bool unlink(linked_stop_source* source) noexcept {
+                linked_stop_source* prev = nullptr;
+                for (auto* current = head; current != nullptr; prev = std::exchange(current, current->m_next)) {
+                    if (current == source) {
+                        (prev != nullptr ? prev->m_next : head) = current->m_next;
+                        if (tail == current) {
+                            tail = prev;
+                        }
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+        };
+
+        // The draining thread notifies after marking the source Processed and only lets go of it by resetting it to
+        // Idle, the destructor waits for both so that it does not free the source under the notification.
+        void wait_processed() const noexcept {
+            m_queued.wait(Queued, std::memory_order_acquire);
+
+            while (m_queued.load(std::memory_order_acquire) != Idle) {
+                EXEC_SPIN_LOCK_HINT();
+            }
+        }
+
+        void parent_stopped() noexcept {
+            if (this_queue.active) {
+                this_queue.push(this);
+            }
+            else {
+                request_stop();
+            }
+        }
+
+        static thread_local propagation_queue this_queue;
+
+        details::stop_state m_state;
+        parent_node m_node{ this };
+        const details::stop_state* m_parent{ nullptr };
+        linked_stop_source* m_next{ nullptr };
+        std::atomic<queue_state> m_queued{ Idle };
+
+    };
+
+    inline thread_local linked_stop_source::propagation_queue linked_stop_source::this_queue{};
+
     class never_stop_token {
         struct callback {
             explicit callback(never_stop_token, auto&&) noexcept {}
@@ -297,7 +506,7 @@ namespace exec {
 
     struct get_stop_token_t {
         template<typename EnvT>
-        requires std::invocable<const std::remove_cvref_t<EnvT>&, get_stop_token_t>
+        requires requires(const EnvT& env, get_stop_token_t tag) { env.query(tag); }
         [[nodiscard]] constexpr decltype(auto) operator()(const EnvT& env) const noexcept {
             return env.query(*this);
         }
@@ -0,0 +1,373 @@
+#ifndef EXEC_TASK_HPP
+#define EXEC_TASK_HPP
+
+#include "exec/allocator.hpp"
+#include "exec/completions.hpp"
+#include "exec/completion_signatures.hpp"
+#include "exec/env.hpp"
+#include "exec/operation_state.hpp"
+#include "exec/receiver.hpp"
+#include "exec/sender.hpp"
+#include "exec/stop_token.hpp"
+
+#include "exec/details/sender_awaitable.hpp"
+#include "exec/details/stop_token_bridge.hpp"
+
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace exec {
+    template<typename T = void, typename AllocT = std::allocator<std::byte>>
+    class task;
+
+    namespace details {
+        template<typename>
+        inline constexpr bool is_task_v = false;
+
+        template<typename T, typename AllocT>
+        inline constexpr bool is_task_v<task<T, AllocT>> = true;
+
+        // Type erased part of a task's promise. An awaited task continues its parent through symmetric transfer, the
+        // root task of a chain completes the receiver of the operation it was connected to.
+        struct task_promise_base {
+            struct final_awaiter {
+                [[nodiscard]] static constexpr bool await_ready() noexcept {
+                    return false;
+                }
+
+                template<typename PromiseT>
+                [[nodiscard]] std::coroutine_handle<> await_suspend(std::coroutine_handle<PromiseT> handle) noexcept {
+                    task_promise_base& promise = handle.promise();
+
+                    if (promise.m_continuation) {
+                        return promise.m_continuation;
+                    }
+
+                    promise.m_on_complete(promise.m_op);
+                    return std::noop_coroutine();
+                }
+
+                static constexpr void await_resume() noexcept {}
+            };
+
+            task_promise_base* m_parent{ nullptr };
+            std::coroutine_handle<> m_continuation{};
+            void* m_op{ nullptr };
+            void (*m_on_complete)(void*) noexcept { nullptr };
+            void (*m_on_stopped)(void*) noexcept { nullptr };
+            inplace_stop_token m_token{};
+            std::exception_ptr m_exception{};
+
+            [[nodiscard]] static constexpr std::suspend_always initial_suspend() noexcept {
+                return {};
+            }
+
+            [[nodiscard]] static constexpr final_awaiter final_suspend() noexcept {
+                return {};
+            }
+
+            void unhandled_exception() noexcept {
+                m_exception = std::current_exception();
+            }
+
+            // A stopped completion unwinds the whole chain of awaiting tasks, the root reports it to its receiver.
+            [[nodiscard]] std::coroutine_handle<> unhandled_stopped() noexcept {
+                auto* root = this;
+                while (root->m_parent != nullptr) {
+                    root = root->m_parent;
+                }
+
+                root->m_on_stopped(root->m_op);
+                return std::noop_coroutine();
+            }
+        };
+
+        template<typename T>
+        struct task_value_signature {
+            using type = exec::set_value_t(T);
+        };
+
+        template<>
+        struct task_value_signature<void> {
+            using type = exec::set_value_t();
+        };
+
+        template<typename T>
+        struct task_value_promise : task_promise_base {
+            std::optional<T> m_value{};
+
+            template<typename U = T>
+            requires std::constructible_from<T, U>
+            void return_value(U&& value) noexcept(std::is_nothrow_constructible_v<T, U>) {
+                m_value.emplace(std::forward<U>(value));
+            }
+
+            [[nodiscard]] T take() {
+                if (m_exception) {
+                    std::rethrow_exception(m_exception);
+                }
+
+                return std::move(*m_value);
+            }
+        };
+
+        template<>
+        struct task_value_promise<void> : task_promise_base {
+            static constexpr void return_void() noexcept {}
+
+            void take() const {
+                if (m_exception) {
+                    std::rethrow_exception(m_exception);
+                }
+            }
+        };
+
+        // Coroutine frames are allocated with the task's allocator, followed by a copy of it for deallocation.
+        template<typename AllocT>
+        struct task_frame_allocator {
+            struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) block {
+                std::byte bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+            };
+
+            using traits_t = std::allocator_traits<AllocT>::template rebind_traits<block>;
+
+            [[nodiscard]] static constexpr std::size_t offset(std::size_t size) noexcept {
+                return (size + alignof(AllocT) - 1) & ~(alignof(AllocT) - 1);
+            }
+
+            [[nodiscard]] static constexpr std::size_t blocks(std::size_t size) noexcept {
+                return (offset(size) + sizeof(AllocT) + sizeof(block) - 1) / sizeof(block);
+            }
+
+            [[nodiscard]] static void* allocate(AllocT alloc, std::size_t size) {
+                typename traits_t::allocator_type block_alloc(alloc);
+                void* const frame = traits_t::allocate(block_alloc, blocks(size));
+
+                ::new (static_cast<std::byte*>(frame) + offset(size)) AllocT(std::move(alloc));
+                return frame;
+            }
+
+            static void deallocate(void* frame, std::size_t size) noexcept {
+                auto* const stored = std::launder(reinterpret_cast<AllocT*>(static_cast<std::byte*>(frame) + offset(size)));
+                typename traits_t::allocator_type block_alloc(std::move(*stored));
+
+                stored->~AllocT();
+                traits_t::deallocate(block_alloc, static_cast<block*>(frame), blocks(size));
+            }
+        };
+    }
+
+    // A lazily started coroutine that is also a sender. Inside the coroutine, senders and other tasks can be awaited,
+    // awaited senders observe the stop token of the receiver the root task was connected to. The frame is allocated
+    // with an AllocT passed as `std::allocator_arg, alloc` leading arguments, or with a default constructed one. The
+    // same allocator is exposed through get_allocator to the awaited senders.
+    template<typename T, typename AllocT>
+    class task {
+        using frame_allocator_t = details::task_frame_allocator<AllocT>;
+
+        struct awaiter;
+
+    public:
+        class promise_type;
+
+        struct env {
+            const promise_type* promise;
+
+            [[nodiscard]] inplace_stop_token query(get_stop_token_t) const noexcept {
+                return promise->m_token;
+            }
+
+            [[nodiscard]] const AllocT& query(get_allocator_t) const noexcept {
+                return promise->m_alloc;
+            }
+        };
+
+        class promise_type : public details::task_value_promise<T> {
+        public:
+            promise_type() requires std::default_initializable<AllocT> = default;
+
+            template<typename OtherAllocT, typename... ArgTs>
+            explicit promise_type(std::allocator_arg_t, const OtherAllocT& alloc, const ArgTs&...) : m_alloc(alloc) {}
+
+            [[nodiscard]] static void* operator new(std::size_t size) requires std::default_initializable<AllocT> {
+                return frame_allocator_t::allocate(AllocT{}, size);
+            }
+
+            template<typename OtherAllocT, typename... ArgTs>
+            [[nodiscard]] static void* operator new(std::size_t size,
+                                                    std::allocator_arg_t,
+                                                    const OtherAllocT& alloc,
+                                                    const ArgTs&...)
+            {
+                return frame_allocator_t::allocate(AllocT(alloc), size);
+            }
+
+            static void operator delete(void* frame, std::size_t size) noexcept {
+                frame_allocator_t::deallocate(frame, size);
+            }
+
+            [[nodiscard]] task get_return_object() noexcept {
+                return task{ std::coroutine_handle<promise_type>::from_promise(*this) };
+            }
+
+            template<typename AwaitableT>
+            [[nodiscard]] decltype(auto) await_transform(AwaitableT&& awaitable) {
+                if constexpr (details::is_task_v<std::remove_cvref_t<AwaitableT>>) {
+                    return std::forward<AwaitableT>(awaitable);
+                }
+                else if constexpr (sender<AwaitableT>) {
+                    return details::sender_awaitable<AwaitableT, promise_type>{
+                        std::forward<AwaitableT>(awaitable), *this };
+                }
+                else {
+                    return std::forward<AwaitableT>(awaitable);
+                }
+            }
+
+            [[nodiscard]] constexpr env get_env() const noexcept {
+                return { this };
+            }
+
+        private:
+            friend struct env;
+
+            AllocT m_alloc{};
+
+        };
+
+        using sender_concept = exec::sender_t;
+
+        using completion_signatures =
+            exec::completion_signatures<typename details::task_value_signature<T>::type,
+                                        exec::set_error_t(std::exception_ptr),
+                                        exec::set_stopped_t()>;
+
+        task(task&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+
+        task& operator=(task&& other) noexcept {
+            if (this != std::addressof(other)) {
+                if (m_handle) {
+                    m_handle.destroy();
+                }
+                m_handle = std::exchange(other.m_handle, {});
+            }
+            return *this;
+        }
+
+        ~task() {
+            if (m_handle) {
+                m_handle.destroy();
+            }
+        }
+
+        template<receiver ReceiverT>
+        [[nodiscard]] auto connect(ReceiverT receiver) && noexcept(std::is_nothrow_move_constructible_v<ReceiverT>) {
+            return operation<ReceiverT>{ std::exchange(m_handle, {}), std::move(receiver) };
+        }
+
+        // Awaiting a task from another task transfers control to it directly and back once it completes.
+        [[nodiscard]] awaiter operator co_await() && noexcept {
+            return awaiter{ m_handle };
+        }
+
+    private:
+        struct awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            [[nodiscard]] static constexpr bool await_ready() noexcept {
+                return false;
+            }
+
+            template<typename PromiseT>
+            requires std::derived_from<PromiseT, details::task_promise_base>
+            [[nodiscard]] std::coroutine_handle<> await_suspend(std::coroutine_handle<PromiseT> parent) noexcept {
+                promise_type& promise = handle.promise();
+
+                promise.m_parent = std::addressof(parent.promise());
+                promise.m_continuation = parent;
+                promise.m_token = parent.promise().m_token;
+                return handle;
+            }
+
+            T await_resume() {
+                return handle.promise().take();
+            }
+        };
+
+        template<typename ReceiverT>
+        class operation {
+        public:
+            using operation_state_concept = exec::operation_state_t;
+
+            explicit operation(std::coroutine_handle<promise_type> handle, ReceiverT&& receiver)
+                noexcept(std::is_nothrow_move_constructible_v<ReceiverT>) :
+                    m_handle(handle),
+                    m_receiver(std::move(receiver)) {}
+
+            operation(operation&&) = delete;
+
+            ~operation() {
+                if (m_handle) {
+                    m_handle.destroy();
+                }
+            }
+
+            void start() & noexcept {
+                promise_type& promise = m_handle.promise();
+
+                promise.m_op = this;
+                promise.m_on_complete = &operation::complete;
+                promise.m_on_stopped = &operation::stopped;
+
+                promise.m_token = m_stop_bridge.attach(get_stop_token(exec::get_env(m_receiver)));
+
+                m_handle.resume();
+            }
+
+        private:
+            static void complete(void* op) noexcept {
+                auto* const self = static_cast<operation*>(op);
+                self->m_stop_bridge.detach();
+
+                try {
+                    if constexpr (std::is_void_v<T>) {
+                        self->m_handle.promise().take();
+                        exec::set_value(std::move(self->m_receiver));
+                    }
+                    else {
+                        exec::set_value(std::move(self->m_receiver), self->m_handle.promise().take());
+                    }
+                }
+                catch (...) {
+                    exec::set_error(std::move(self->m_receiver), std::current_exception());
+                }
+            }
+
+            static void stopped(void* op) noexcept {
+                auto* const self = static_cast<operation*>(op);
+                self->m_stop_bridge.detach();
+
+                exec::set_stopped(std::move(self->m_receiver));
+            }
+
+            std::coroutine_handle<promise_type> m_handle;
+            ReceiverT m_receiver;
+            details::stop_token_bridge<stop_token_of_t<env_of_t<ReceiverT>>> m_stop_bridge{};
+
+        };
+
+        explicit task(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) {}
+
+        std::coroutine_handle<promise_type> m_handle;
+
+    };
+}
+
+#endif // !EXEC_TASK_HPP
\ No newline at end of file
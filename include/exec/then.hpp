@@ -29,6 +29,59 @@ namespace exec {
     template<typename CompletionT>
     struct then_tag_t {};
 
+    namespace details {
+        // then(first) | then(second) as a single invocable, second receives what first returns or nothing when it
+        // returns void. A reference returned by second into the temporary returned by first is returned by value,
+        // since that temporary dies with the call.
+        template<typename FirstT, typename SecondT>
+        struct then_composition {
+            template<typename Self>
+            using first_t = decltype(std::forward_like<Self>(std::declval<FirstT>()));
+
+            template<typename Self>
+            using second_t = decltype(std::forward_like<Self>(std::declval<SecondT>()));
+
+            template<typename Self, typename... ArgTs>
+            using first_result_t = std::invoke_result_t<first_t<Self>, ArgTs...>;
+
+            template<typename Self, typename... ArgTs>
+            static constexpr bool is_nothrow = [] {
+                if constexpr (std::is_void_v<first_result_t<Self, ArgTs...>>) {
+                    return std::is_nothrow_invocable_v<first_t<Self>, ArgTs...> &&
+                           std::is_nothrow_invocable_v<second_t<Self>>;
+                }
+                else {
+                    return std::is_nothrow_invocable_v<first_t<Self>, ArgTs...> &&
+                           std::is_nothrow_invocable_v<second_t<Self>, first_result_t<Self, ArgTs...>>;
+                }
+            }();
+
+            template<typename Self, typename... ArgTs>
+            constexpr decltype(auto) operator()(this Self&& self, ArgTs&&... args) noexcept(is_nothrow<Self, ArgTs...>) {
+                using intermediate_t = first_result_t<Self, ArgTs...>;
+
+                if constexpr (std::is_void_v<intermediate_t>) {
+                    std::invoke(std::forward_like<Self>(self.first), std::forward<ArgTs>(args)...);
+                    return std::invoke(std::forward_like<Self>(self.second));
+                }
+                else if constexpr (!std::is_reference_v<intermediate_t> &&
+                                   std::is_reference_v<std::invoke_result_t<second_t<Self>, intermediate_t>>)
+                {
+                    return std::remove_cvref_t<std::invoke_result_t<second_t<Self>, intermediate_t>>(
+                        std::invoke(std::forward_like<Self>(self.second),
+                                    std::invoke(std::forward_like<Self>(self.first), std::forward<ArgTs>(args)...)));
+                }
+                else {
+                    return std::invoke(std::forward_like<Self>(self.second),
+                                       std::invoke(std::forward_like<Self>(self.first), std::forward<ArgTs>(args)...));
+                }
+            }
+
+            [[no_unique_address]] FirstT first;
+            [[no_unique_address]] SecondT second;
+        };
+    }
+
     template<typename CompletionT>
     struct details::impls_for<then_tag_t<CompletionT>> : default_impls {
         template<typename... Args>
@@ -114,6 +167,23 @@ namespace exec {
             return details::make_sender(*this, std::forward<InvocableT>(invocable), std::forward<SenderT>(input));
         }
 
+        // Adjacent thens are fused into one sender calling the composed invocables, so that a chain of them costs a
+        // single operation state and completes through straight calls instead of one receiver hop per link.
+        template<typename FirstT, typename ChildT, typename InvocableT>
+        [[nodiscard]] constexpr auto operator()(details::basic_sender<then_tag_t, FirstT, ChildT> input,
+                                                InvocableT&& invocable) const
+        {
+            return std::move(input).apply([&](auto, FirstT&& first, ChildT&& child) {
+                return details::make_sender(
+                    *this,
+                    details::then_composition<FirstT, std::decay_t<InvocableT>>{
+                        std::move(first),
+                        std::forward<InvocableT>(invocable)
+                    },
+                    std::move(child));
+            });
+        }
+
         template<typename InvocableT>
         [[nodiscard]] constexpr auto operator()(InvocableT&& invocable) const {
             return details::basic_closure{
@@ -0,0 +1,480 @@
+#ifndef EXEC_TIMED_RUN_LOOP_HPP
+#define EXEC_TIMED_RUN_LOOP_HPP
+
+#include "exec/completions.hpp"
+#include "exec/completion_signatures.hpp"
+#include "exec/env.hpp"
+#include "exec/operation_state.hpp"
+#include "exec/receiver.hpp"
+#include "exec/scheduler.hpp"
+#include "exec/sender.hpp"
+#include "exec/stop_token.hpp"
+#include "exec/timed_scheduler.hpp"
+
+#include "exec/details/atomic_intrusive_queue.hpp"
+#include "exec/details/intrusive_queue.hpp"
+#include "exec/details/intrusive_task.hpp"
+#include "exec/details/timer_wheel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace exec {
+    // run_loop with a hierarchical timer wheel. Deadlines are tracked in 1ms ticks and rounded up, so a timer never
+    // completes before its time point. A timer whose stop token is triggered leaves the wheel right away and
+    // completes with set_stopped on the loop. finish() stops every pending timer.
+    class timed_run_loop {
+    public:
+        using clock = std::chrono::steady_clock;
+        using time_point = clock::time_point;
+        using duration = clock::duration;
+
+        using tick_duration = std::chrono::milliseconds;
+
+    private:
+        enum class timer_state : std::uint8_t {
+            idle,
+            armed,
+            cancelled,
+            fired
+        };
+
+        struct timer_base : details::intrusive_task, details::timer_node {
+            explicit timer_base(execute_fn* execute) noexcept : intrusive_task(execute) {}
+
+            timer_state state{ timer_state::idle };
+        };
+
+        template<receiver ReceiverT>
+        struct operation_state : details::intrusive_task {
+            using operation_state_concept = operation_state_t;
+
+            explicit operation_state(timed_run_loop* loop, receiver auto&& receiver) noexcept :
+                intrusive_task(&operation_state::execute),
+                loop(loop),
+                receiver(std::forward<decltype(receiver)>(receiver)) {}
+
+            timed_run_loop* loop;
+            ReceiverT receiver;
+
+            static void execute(intrusive_task* task) noexcept {
+                auto& self = *static_cast<operation_state*>(task);
+
+                if (get_stop_token(exec::get_env(self.receiver)).stop_requested()) {
+                    set_stopped(std::move(self.receiver));
+                }
+                else {
+                    set_value(std::move(self.receiver));
+                }
+            }
+
+            void start() noexcept {
+                try {
+                    loop->push_back(this);
+                }
+                catch (...) {
+                    set_error(std::move(receiver), std::current_exception());
+                }
+            }
+        };
+
+        template<receiver ReceiverT, typename TimeT>
+        struct timer_operation_state : timer_base {
+            struct on_stop {
+                timer_operation_state* self;
+
+                void operator()() const noexcept {
+                    self->loop->cancel_timer(self);
+                }
+            };
+
+            using operation_state_concept = operation_state_t;
+
+            using stop_token_t = stop_token_of_t<env_of_t<ReceiverT>>;
+            using stop_callback_t = typename stop_token_t::template callback_type<on_stop>;
+
+            explicit timer_operation_state(timed_run_loop* loop, TimeT time, receiver auto&& receiver) noexcept :
+                timer_base(&timer_operation_state::execute),
+                loop(loop),
+                time(time),
+                receiver(std::forward<decltype(receiver)>(receiver)) {}
+
+            timed_run_loop* loop;
+            TimeT time;
+            ReceiverT receiver;
+            std::optional<stop_callback_t> stop_callback{};
+
+            static void execute(intrusive_task* task) noexcept {
+                auto& self = *static_cast<timer_operation_state*>(task);
+                self.stop_callback.reset();
+
+                if (self.state == timer_state::cancelled ||
+                    get_stop_token(exec::get_env(self.receiver)).stop_requested()) {
+                    set_stopped(std::move(self.receiver));
+                }
+                else {
+                    set_value(std::move(self.receiver));
+                }
+            }
+
+            void start() noexcept {
+                auto token = get_stop_token(exec::get_env(receiver));
+                if (token.stop_requested()) {
+                    set_stopped(std::move(receiver));
+                    return;
+                }
+
+                stop_callback.emplace(token, on_stop{ this });
+
+                try {
+                    if constexpr (std::is_same_v<TimeT, duration>) {
+                        loop->arm_timer(this, clock::now() + time);
+                    }
+                    else {
+                        loop->arm_timer(this, time);
+                    }
+                }
+                catch (...) {
+                    stop_callback.reset();
+                    set_error(std::move(receiver), std::current_exception());
+                }
+            }
+        };
+
+        struct scheduler;
+
+        struct env {
+            timed_run_loop* loop;
+
+            [[nodiscard]] constexpr auto query(get_completion_scheduler_t<set_value_t>) const noexcept {
+                return loop->get_scheduler();
+            }
+
+            [[nodiscard]] constexpr auto query(get_completion_scheduler_t<set_stopped_t>) const noexcept {
+                return loop->get_scheduler();
+            }
+        };
+
+        struct scheduler {
+            struct sender {
+                using sender_concept = sender_t;
+
+                using completion_signatures =
+                    completion_signatures<set_value_t(), set_error_t(std::exception_ptr), set_stopped_t()>;
+
+                timed_run_loop* loop;
+
+                [[nodiscard]] auto get_env() const noexcept {
+                    return env{ loop };
+                }
+
+                constexpr auto connect(receiver auto&& rcvr) {
+                    return operation_state<std::decay_t<decltype(rcvr)>>(loop, std::forward<decltype(rcvr)>(rcvr));
+                }
+            };
+
+            template<typename TimeT>
+            struct timer_sender {
+                using sender_concept = sender_t;
+
+                using completion_signatures =
+                    completion_signatures<set_value_t(), set_error_t(std::exception_ptr), set_stopped_t()>;
+
+                timed_run_loop* loop;
+                TimeT time;
+
+                [[nodiscard]] auto get_env() const noexcept {
+                    return env{ loop };
+                }
+
+                constexpr auto connect(receiver auto&& rcvr) {
+                    return timer_operation_state<std::decay_t<decltype(rcvr)>, TimeT>(
+                        loop, time, std::forward<decltype(rcvr)>(rcvr));
+                }
+            };
+
+            using scheduler_concept = scheduler_t;
+
+            timed_run_loop* loop;
+
+            [[nodiscard]] constexpr sender schedule() const {
+                return sender{ loop };
+            }
+
+            [[nodiscard]] constexpr timer_sender<time_point> schedule_at(time_point deadline) const {
+                return timer_sender<time_point>{ loop, deadline };
+            }
+
+            [[nodiscard]] constexpr timer_sender<duration> schedule_after(duration delay) const {
+                return timer_sender<duration>{ loop, delay };
+            }
+
+            [[nodiscard]] static time_point now() noexcept {
+                return clock::now();
+            }
+
+        private:
+            [[nodiscard]]
+            friend constexpr bool operator==(const scheduler& left, const scheduler& right) noexcept {
+                return left.loop == right.loop;
+            }
+
+        };
+
+    public:
+        timed_run_loop() noexcept = default;
+
+        timed_run_loop(timed_run_loop&&) = delete;
+
+        ~timed_run_loop() noexcept {
+            while (m_pushers.load(std::memory_order_acquire) != 0) {
+                std::this_thread::yield();
+            }
+
+            bool pending{};
+            {
+                std::scoped_lock lock(m_timer_mutex, m_mutex);
+                pending = !m_wheel.empty() || !m_queue.empty();
+            }
+
+            if (pending || !m_finished.load(std::memory_order_acquire)) {
+                std::terminate();
+            }
+        }
+
+        constexpr scheduler get_scheduler() noexcept {
+            return scheduler{ this };
+        }
+
+        void run() {
+            while (true) {
+                run_expired_timers();
+
+                auto tasks = m_queue.pop_all();
+                if (!tasks.empty()) {
+                    while (auto* task = tasks.pop_front()) {
+                        task->execute();
+                    }
+
+                    continue;
+                }
+
+                if (m_finished.load(std::memory_order_seq_cst)) {
+                    if (drained()) {
+                        return;
+                    }
+
+                    if (m_queue.empty()) {
+                        std::this_thread::yield();
+                    }
+
+                    continue;
+                }
+
+                park();
+            }
+        }
+
+        // Runners observe m_finished without the lock and may return while the notification below is still running.
+        // It is ~timed_run_loop taking m_mutex that keeps the loop alive until finish() unlocks.
+        void finish() noexcept {
+            {
+                std::scoped_lock lock(m_timer_mutex);
+                m_timers_closed = true;
+
+                details::intrusive_queue<details::timer_node> pending;
+                m_wheel.take_all(pending);
+
+                while (auto* node = pending.pop_front()) {
+                    auto* const timer = static_cast<timer_base*>(node);
+                    timer->state = timer_state::cancelled;
+                    m_queue.push(timer);
+                }
+            }
+
+            std::scoped_lock lock(m_mutex);
+            m_finished.store(true, std::memory_order_seq_cst);
+            m_cv.notify_all();
+        }
+
+    private:
+        // Registers a call that may make a task visible to the runners and notify them afterwards. As in run_loop,
+        // either it sees finish() or a runner that sees finish() waits for it in drained(), so a task is neither
+        // stranded in a finished loop nor notified into a destroyed one.
+        struct push_scope {
+            explicit push_scope(timed_run_loop* loop) noexcept : loop(loop) {
+                loop->m_pushers.fetch_add(1, std::memory_order_seq_cst);
+            }
+
+            ~push_scope() noexcept {
+                loop->m_pushers.fetch_sub(1, std::memory_order_release);
+            }
+
+            push_scope(push_scope&&) = delete;
+
+            timed_run_loop* loop;
+        };
+
+        void push_back(details::intrusive_task* task) {
+            const push_scope scope(this);
+
+            if (m_finished.load(std::memory_order_seq_cst)) {
+                throw std::runtime_error("Invalid operation on finished run loop.");
+            }
+
+            m_queue.push(task);
+            notify_waiters();
+        }
+
+        // Called once m_finished has been observed. The pushers are read before the queue, a push that had
+        // deregistered is then visible in it.
+        [[nodiscard]] bool drained() const noexcept {
+            return m_pushers.load(std::memory_order_seq_cst) == 0 && m_queue.empty();
+        }
+
+        void arm_timer(timer_base* timer, time_point deadline) {
+            const auto tick = to_tick(deadline);
+            const push_scope scope(this);
+            {
+                std::scoped_lock lock(m_timer_mutex);
+                if (m_timers_closed) {
+                    throw std::runtime_error("Invalid operation on finished run loop.");
+                }
+
+                // The stop callback fired before the timer was armed.
+                if (timer->state == timer_state::cancelled) {
+                    m_queue.push(timer);
+                }
+                else {
+                    timer->state = timer_state::armed;
+                    timer->deadline = tick;
+                    m_wheel.insert(timer);
+
+                    if (tick >= m_next_tick.load(std::memory_order_relaxed)) {
+                        return;
+                    }
+
+                    m_next_tick.store(tick, std::memory_order_seq_cst);
+                }
+            }
+
+            notify_waiters();
+        }
+
+        // Pushing while the timer mutex is held keeps the completion ahead of a concurrent finish().
+        void cancel_timer(timer_base* timer) noexcept {
+            const push_scope scope(this);
+            {
+                std::scoped_lock lock(m_timer_mutex);
+                if (timer->state == timer_state::idle) {
+                    timer->state = timer_state::cancelled;
+                    return;
+                }
+
+                if (timer->state != timer_state::armed) {
+                    return;
+                }
+
+                m_wheel.remove(timer);
+                timer->state = timer_state::cancelled;
+                m_queue.push(timer);
+            }
+
+            notify_waiters();
+        }
+
+        void run_expired_timers() {
+            const auto tick = current_tick();
+            if (tick < m_next_tick.load(std::memory_order_acquire)) {
+                return;
+            }
+
+            details::intrusive_queue<details::intrusive_task> ready;
+            {
+                std::scoped_lock lock(m_timer_mutex);
+
+                details::intrusive_queue<details::timer_node> expired;
+                m_wheel.advance(tick, expired);
+                m_next_tick.store(m_wheel.next_tick(), std::memory_order_seq_cst);
+
+                while (auto* node = expired.pop_front()) {
+                    auto* const timer = static_cast<timer_base*>(node);
+                    timer->state = timer_state::fired;
+                    ready.push_back(timer);
+                }
+            }
+
+            while (auto* task = ready.pop_front()) {
+                task->execute();
+            }
+        }
+
+        void park() {
+            std::unique_lock lock(m_mutex);
+            m_waiters.fetch_add(1, std::memory_order_seq_cst);
+
+            const auto next = m_next_tick.load(std::memory_order_seq_cst);
+            const auto ready = [this, next]() noexcept -> bool {
+                return m_finished.load(std::memory_order_relaxed) ||
+                       !m_queue.empty() ||
+                       m_next_tick.load(std::memory_order_relaxed) < next ||
+                       current_tick() >= next;
+            };
+
+            if (next == details::timer_wheel::never) {
+                m_cv.wait(lock, ready);
+            }
+            else {
+                m_cv.wait_until(lock, m_epoch + tick_duration(next), ready);
+            }
+
+            m_waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        void notify_waiters() noexcept {
+            if (m_waiters.load(std::memory_order_seq_cst) > 0) {
+                std::scoped_lock lock(m_mutex);
+                m_cv.notify_one();
+            }
+        }
+
+        [[nodiscard]] std::uint64_t to_tick(time_point deadline) const noexcept {
+            if (deadline <= m_epoch) {
+                return 0;
+            }
+
+            return static_cast<std::uint64_t>(std::chrono::ceil<tick_duration>(deadline - m_epoch).count());
+        }
+
+        [[nodiscard]] std::uint64_t current_tick() const noexcept {
+            return static_cast<std::uint64_t>(std::chrono::floor<tick_duration>(clock::now() - m_epoch).count());
+        }
+
+        const time_point m_epoch{ clock::now() };
+
+        alignas(64) details::atomic_intrusive_queue<details::intrusive_task> m_queue;
+        alignas(64) std::atomic_size_t m_pushers{ 0 };
+        alignas(64) std::atomic_size_t m_waiters{ 0 };
+        std::atomic_bool m_finished{ false };
+        std::atomic_uint64_t m_next_tick{ details::timer_wheel::never };
+
+        alignas(64) std::mutex m_timer_mutex;
+        details::timer_wheel m_wheel;
+        bool m_timers_closed{ false };
+
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+
+    };
+}
+
+#endif // !EXEC_TIMED_RUN_LOOP_HPP
\ No newline at end of file
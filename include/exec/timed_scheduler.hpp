@@ -0,0 +1,47 @@
+#ifndef EXEC_TIMED_SCHEDULER_HPP
+#define EXEC_TIMED_SCHEDULER_HPP
+
+#include "exec/scheduler.hpp"
+#include "exec/sender.hpp"
+
+#include <utility>
+
+namespace exec {
+    struct now_t {
+        [[nodiscard]] constexpr auto operator()(const auto& schd) const noexcept(noexcept(schd.now())) {
+            return schd.now();
+        }
+    };
+    inline constexpr now_t now{};
+
+    struct schedule_at_t {
+        [[nodiscard]] constexpr sender auto operator()(auto&& schd, const auto& time_point) const {
+            return std::forward<decltype(schd)>(schd).schedule_at(time_point);
+        }
+    };
+    inline constexpr schedule_at_t schedule_at{};
+
+    struct schedule_after_t {
+        [[nodiscard]] constexpr sender auto operator()(auto&& schd, const auto& duration) const {
+            return std::forward<decltype(schd)>(schd).schedule_after(duration);
+        }
+    };
+    inline constexpr schedule_after_t schedule_after{};
+
+    template<typename T>
+    concept timed_scheduler =
+        scheduler<T> &&
+        requires(T&& schd) {
+            now(schd);
+            { schedule_at(std::forward<T>(schd), now(schd)) } -> sender;
+            { schedule_after(std::forward<T>(schd), now(schd) - now(schd)) } -> sender;
+        };
+
+    template<timed_scheduler T>
+    using time_point_of_t = decltype(now(std::declval<T>()));
+
+    template<timed_scheduler T>
+    using duration_of_t = decltype(now(std::declval<T>()) - now(std::declval<T>()));
+}
+
+#endif // !EXEC_TIMED_SCHEDULER_HPP
\ No newline at end of file
@@ -0,0 +1,192 @@
+#ifndef EXEC_TRACE_RECORDER_HPP
+#define EXEC_TRACE_RECORDER_HPP
+
+#include "exec/tracer.hpp"
+
+#include "exec/details/thread_index.hpp"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <utility>
+
+namespace exec {
+    // Collects trace events into one ring buffer per recording thread. A thread finds its buffer through a
+    // thread-local cache and appends to it with a single release store, buffers are only ever pushed onto a lock-free
+    // list, so recording never blocks. Each ring keeps the most recent `events_per_thread` events, older ones are
+    // overwritten. write_chrome_trace() reads every ring and must not run while operations are still being traced.
+    class trace_recorder {
+        struct alignas(64) ring {
+            ring(std::size_t capacity, std::size_t thread) :
+                events(std::make_unique<trace_event[]>(capacity)),
+                mask(capacity - 1),
+                thread(thread) {}
+
+            void push(const trace_event& event) noexcept {
+                const std::uint64_t position = head.load(std::memory_order_relaxed);
+                events[position & mask] = event;
+                head.store(position + 1, std::memory_order_release);
+            }
+
+            std::unique_ptr<trace_event[]> events;
+            std::size_t mask;
+            std::size_t thread;
+            std::atomic_uint64_t head{ 0 };
+            ring* next{ nullptr };
+        };
+
+        struct thread_cache {
+            std::uint64_t recorder_id{ 0 };
+            ring* buffer{ nullptr };
+        };
+
+    public:
+        class tracer {
+        public:
+            void record(const trace_event& event) const noexcept {
+                if (ring* buffer = m_recorder->this_thread_ring()) {
+                    buffer->push(event);
+                }
+            }
+
+        private:
+            friend class trace_recorder;
+
+            constexpr explicit tracer(trace_recorder* recorder) noexcept : m_recorder(recorder) {}
+
+            [[nodiscard]] friend constexpr bool operator==(const tracer& left, const tracer& right) noexcept {
+                return left.m_recorder == right.m_recorder;
+            }
+
+            trace_recorder* m_recorder;
+
+        };
+
+        explicit trace_recorder(std::size_t events_per_thread = 1 << 14) :
+            m_capacity(std::bit_ceil(events_per_thread < 2 ? 2 : events_per_thread)) {}
+
+        trace_recorder(trace_recorder&&) = delete;
+
+        ~trace_recorder() noexcept {
+            ring* current = m_rings.load(std::memory_order_acquire);
+            while (current != nullptr) {
+                delete std::exchange(current, current->next);
+            }
+        }
+
+        [[nodiscard]] constexpr tracer get_tracer() noexcept {
+            return tracer{ this };
+        }
+
+        // Writes the recorded events in the Chrome trace_event JSON format, as complete ("X") events on the thread
+        // that made the call, loadable in chrome://tracing or Perfetto.
+        void write_chrome_trace(std::ostream& out) const {
+            out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+            bool first = true;
+            for (const ring* current = m_rings.load(std::memory_order_acquire);
+                 current != nullptr;
+                 current = current->next)
+            {
+                const std::uint64_t head = current->head.load(std::memory_order_acquire);
+                const std::uint64_t count = head < current->mask + 1 ? head : current->mask + 1;
+
+                for (std::uint64_t position = head - count; position < head; ++position) {
+                    const trace_event& event = current->events[position & current->mask];
+
+                    out << (std::exchange(first, false) ? "\n" : ",\n");
+                    write_chrome_event(out, event);
+                }
+            }
+
+            out << "\n]}\n";
+        }
+
+    private:
+        // An event recorded by a thread whose ring cannot be allocated is dropped.
+        [[nodiscard]] ring* this_thread_ring() noexcept {
+            thread_cache& cache = this_thread_cache;
+            if (cache.recorder_id != m_id) {
+                try {
+                    cache.buffer = find_or_add_ring();
+                    cache.recorder_id = m_id;
+                }
+                catch (...) {
+                    return nullptr;
+                }
+            }
+
+            return cache.buffer;
+        }
+
+        // Only the calling thread adds its own ring, so the lookup cannot race with another insertion of the same one.
+        ring* find_or_add_ring() {
+            const std::size_t thread = details::thread_index();
+
+            ring* head = m_rings.load(std::memory_order_acquire);
+            for (ring* current = head; current != nullptr; current = current->next) {
+                if (current->thread == thread) {
+                    return current;
+                }
+            }
+
+            auto* added = new ring(m_capacity, thread);
+            added->next = head;
+            while (!m_rings.compare_exchange_weak(added->next, added,
+                                                  std::memory_order_release,
+                                                  std::memory_order_acquire))
+            {}
+
+            return added;
+        }
+
+        static void write_chrome_event(std::ostream& out, const trace_event& event) {
+            static constexpr std::string_view phases[] = { "start", "set_value", "set_error", "set_stopped" };
+
+            out << "{\"name\":\"";
+            for (const char c : event.tag) {
+                if (c == '"' || c == '\\') {
+                    out << '\\';
+                }
+                out << c;
+            }
+
+            out << "\",\"cat\":\"" << phases[static_cast<std::size_t>(event.phase)] << "\",\"ph\":\"X\"";
+            out << ",\"ts\":";
+            write_microseconds(out, event.begin_ns);
+            out << ",\"dur\":";
+            write_microseconds(out, event.end_ns - event.begin_ns);
+            out << ",\"pid\":1,\"tid\":" << event.thread << '}';
+        }
+
+        static void write_microseconds(std::ostream& out, std::int64_t ns) {
+            const char fraction[] = { '.',
+                                      static_cast<char>('0' + ns % 1000 / 100),
+                                      static_cast<char>('0' + ns % 100 / 10),
+                                      static_cast<char>('0' + ns % 10) };
+
+            out << ns / 1000;
+            out.write(fraction, sizeof(fraction));
+        }
+
+        [[nodiscard]] static std::uint64_t next_id() noexcept {
+            static constinit std::atomic_uint64_t next{ 1 };
+            return next.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static thread_local thread_cache this_thread_cache;
+
+        std::size_t m_capacity;
+        std::uint64_t m_id{ next_id() };
+        std::atomic<ring*> m_rings{ nullptr };
+
+    };
+
+    inline thread_local trace_recorder::thread_cache trace_recorder::this_thread_cache{};
+}
+
+#endif // !EXEC_TRACE_RECORDER_HPP
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef EXEC_TRACER_HPP
+#define EXEC_TRACER_HPP
+
+#include "exec/forwarding_query.hpp"
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace exec {
+    enum class trace_phase : std::uint8_t {
+        start,
+        set_value,
+        set_error,
+        set_stopped
+    };
+
+    // One traced call of a sender algorithm: starting its operation, or one of its children completing into it. The
+    // call runs between begin_ns and end_ns (steady_clock), which includes whatever it ran synchronously downstream.
+    struct trace_event {
+        std::string_view tag;
+        trace_phase phase;
+        std::size_t thread;
+        std::int64_t begin_ns;
+        std::int64_t end_ns;
+    };
+
+    template<typename T>
+    concept tracer =
+        std::copy_constructible<T> &&
+        requires(const T& tracer, const trace_event& event) {
+            { tracer.record(event) } noexcept;
+        };
+
+    struct get_tracer_t {
+        template<typename EnvT>
+        [[nodiscard]] constexpr tracer auto operator()(const EnvT& env) const noexcept {
+            return env.query(*this);
+        }
+
+        [[nodiscard]] static consteval bool query(forwarding_query_t) noexcept {
+            return true;
+        }
+    };
+    inline constexpr get_tracer_t get_tracer{};
+
+    namespace details {
+        [[nodiscard]] inline std::int64_t trace_now() noexcept {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+    }
+}
+
+#endif // !EXEC_TRACER_HPP
\ No newline at end of file
@@ -0,0 +1,562 @@
+#ifndef EXEC_WHEN_ALL_HPP
+#define EXEC_WHEN_ALL_HPP
+
+#include "exec/allocator.hpp"
+#include "exec/completions.hpp"
+#include "exec/completion_signatures.hpp"
+#include "exec/env.hpp"
+#include "exec/operation_state.hpp"
+#include "exec/receiver.hpp"
+#include "exec/sender.hpp"
+#include "exec/stop_token.hpp"
+
+#include "exec/details/basic_sender.hpp"
+#include "exec/details/decayed_tuple.hpp"
+#include "exec/details/forward_env.hpp"
+#include "exec/details/gather_signatures.hpp"
+#include "exec/details/join_env.hpp"
+#include "exec/details/meta_add.hpp"
+#include "exec/details/meta_bind.hpp"
+#include "exec/details/meta_merge.hpp"
+#include "exec/details/product_type.hpp"
+#include "exec/details/type_list.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace exec {
+    struct when_all_t;
+    struct when_all_range_t;
+
+    template<>
+    struct details::impls_for<when_all_t> : default_impls {
+        template<typename... TupleTs>
+        struct single_value {
+            static_assert(sizeof...(TupleTs) <= 1, "when_all requires senders with at most one value completion.");
+
+            using type = std::tuple<>;
+        };
+
+        template<typename TupleT>
+        struct single_value<TupleT> {
+            using type = TupleT;
+        };
+
+        template<typename... TupleTs>
+        using single_value_t = single_value<TupleTs...>::type;
+
+        template<typename SenderT, typename EnvT>
+        using values_of_t =
+            gather_signatures<exec::set_value_t, completion_signatures_of_t<SenderT, EnvT>, decayed_tuple, single_value_t>;
+
+        template<typename ErrorT>
+        using error_signature_t = completion_signatures<exec::set_error_t(std::decay_t<ErrorT>)>;
+
+        template<typename SenderT, typename EnvT>
+        using errors_of_t =
+            gather_signatures<exec::set_error_t,
+                              completion_signatures_of_t<SenderT, EnvT>,
+                              error_signature_t,
+                              meta_bind_front<meta_add_t, completion_signatures<>>::type>;
+
+        template<typename... Ts>
+        using value_signature_t = completion_signatures<exec::set_value_t(Ts...)>;
+
+        template<typename... Ts>
+        struct nothrow_decay_copyable {
+            static constexpr bool value =
+                ((std::is_nothrow_copy_constructible_v<Ts> && std::is_nothrow_move_constructible_v<Ts>) && ... && true);
+        };
+
+        template<typename EnvT, typename... ChildTs>
+        struct signatures {
+            using values_t = meta_add_t<std::tuple<>, values_of_t<ChildTs, EnvT>...>;
+            using errors_t = meta_merge_t<completion_signatures<>, errors_of_t<ChildTs, EnvT>...>;
+
+            static constexpr bool nothrow =
+                elements_of<values_t>::template apply<nothrow_decay_copyable>::value &&
+                gather_signatures<exec::set_error_t, errors_t, std::type_identity_t, nothrow_decay_copyable>::value;
+
+            using type =
+                meta_merge_t<typename elements_of<values_t>::template apply<value_signature_t>,
+                             errors_t,
+                             completion_signatures<exec::set_stopped_t()>,
+                             std::conditional_t<nothrow,
+                                                completion_signatures<>,
+                                                completion_signatures<exec::set_error_t(std::exception_ptr)>>>;
+        };
+
+        // Children share a single inplace_stop_source: the first error or stop, as well as a stop request from the
+        // receiver, cancels the siblings.
+        template<typename ReceiverT, typename ErrorsT>
+        struct shared_state {
+            enum class disposition : std::uint8_t {
+                running,
+                error,
+                stopped
+            };
+
+            struct on_stop {
+                inplace_stop_source& source;
+
+                void operator()() const noexcept {
+                    source.request_stop();
+                }
+            };
+
+            using stop_token_t = stop_token_of_t<env_of_t<ReceiverT>>;
+            using stop_callback_t = typename stop_token_t::template callback_type<on_stop>;
+
+            std::atomic<disposition> status{ disposition::running };
+            inplace_stop_source stop_source{};
+            std::optional<stop_callback_t> stop_callback{};
+            ErrorsT errors{};
+
+            template<typename ErrorT>
+            void store_error(ErrorT&& error) noexcept {
+                auto expected = disposition::running;
+                while (!status.compare_exchange_weak(expected, disposition::error, std::memory_order_relaxed)) {
+                    if (expected == disposition::error) {
+                        return;
+                    }
+                }
+
+                try {
+                    errors.template emplace<std::decay_t<ErrorT>>(std::forward<ErrorT>(error));
+                }
+                catch (...) {
+                    if constexpr (!std::is_nothrow_constructible_v<std::decay_t<ErrorT>, ErrorT>) {
+                        errors.template emplace<std::exception_ptr>(std::current_exception());
+                    }
+                }
+
+                stop_source.request_stop();
+            }
+
+            void store_stopped() noexcept {
+                auto expected = disposition::running;
+                if (status.compare_exchange_strong(expected, disposition::stopped, std::memory_order_relaxed)) {
+                    stop_source.request_stop();
+                }
+            }
+
+            // Returns false if the receiver was already asked to stop, in which case it has been completed.
+            [[nodiscard]] bool try_start(ReceiverT& receiver) noexcept {
+                auto token = get_stop_token(exec::get_env(receiver));
+                if (token.stop_requested()) {
+                    exec::set_stopped(std::move(receiver));
+                    return false;
+                }
+
+                stop_callback.emplace(token, on_stop{ stop_source });
+                return true;
+            }
+
+            // Returns true if the receiver has been completed with an error or stopped.
+            [[nodiscard]] bool try_complete_cancelled(ReceiverT& receiver) noexcept {
+                stop_callback.reset();
+
+                switch (status.load(std::memory_order_relaxed)) {
+                    case disposition::error:
+                        std::visit([&]<typename ErrorT>(ErrorT& error) noexcept {
+                            if constexpr (!std::is_same_v<ErrorT, std::monostate>) {
+                                exec::set_error(std::move(receiver), std::move(error));
+                            }
+                        }, errors);
+                        return true;
+                    case disposition::stopped:
+                        exec::set_stopped(std::move(receiver));
+                        return true;
+                    case disposition::running:
+                        if (get_stop_token(exec::get_env(receiver)).stop_requested()) {
+                            exec::set_stopped(std::move(receiver));
+                            return true;
+                        }
+                        return false;
+                }
+
+                return false;
+            }
+        };
+
+        // Each child stores its values in place, the last one to arrive completes.
+        template<typename ReceiverT, typename ValuesT, typename ErrorsT, std::size_t COUNT>
+        struct state : shared_state<ReceiverT, ErrorsT> {
+            std::atomic_size_t count{ COUNT };
+            ValuesT values{};
+
+            void arrive(ReceiverT& receiver) noexcept {
+                if (count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    complete(receiver);
+                }
+            }
+
+            void complete(ReceiverT& receiver) noexcept {
+                if (this->try_complete_cancelled(receiver)) {
+                    return;
+                }
+
+                std::move(values).apply([&]<typename... OptionalTs>(OptionalTs&&... results) noexcept {
+                    std::apply([&]<typename... Ts>(Ts&&... args) noexcept {
+                        exec::set_value(std::move(receiver), std::forward<Ts>(args)...);
+                    }, std::tuple_cat(std::move(*results)...));
+                });
+            }
+        };
+
+        static constexpr auto get_completion_signatures =
+            []<typename SenderT, typename EnvT>(SenderT&& sender, EnvT&&) noexcept {
+                return std::forward<SenderT>(sender).apply([]<typename... ChildTs>(auto&&, auto&&, ChildTs&&...) noexcept {
+                    return typename signatures<std::decay_t<EnvT>, ChildTs...>::type{};
+                });
+            };
+
+        static constexpr auto get_env =
+            []<typename ReceiverT>(auto, auto& state, const ReceiverT& receiver) noexcept {
+                return join_env(prop{ get_stop_token, state.stop_source.get_token() },
+                                forward_env(exec::get_env(receiver)));
+            };
+
+        static constexpr auto get_state =
+            []<typename SenderT, typename ReceiverT>(SenderT&& sender, ReceiverT&) noexcept {
+                return std::forward<SenderT>(sender).apply([]<typename... ChildTs>(auto&&, auto&&, ChildTs&&...) noexcept {
+                    using env_t = env_of_t<ReceiverT>;
+                    using signatures_t = signatures<env_t, ChildTs...>;
+                    using values_t = product_type<std::optional<values_of_t<ChildTs, env_t>>...>;
+                    using errors_t =
+                        meta_add_t<std::variant<std::monostate>,
+                                   gather_signatures<exec::set_error_t,
+                                                     typename signatures_t::type,
+                                                     std::type_identity_t,
+                                                     std::variant>>;
+
+                    return state<ReceiverT, values_t, errors_t, sizeof...(ChildTs)>{};
+                });
+            };
+
+        static constexpr auto start =
+            []<typename StateT, typename ReceiverT, typename... OperationTs>
+                (StateT& state, ReceiverT& receiver, OperationTs&... operations) noexcept
+            {
+                if (!state.try_start(receiver)) {
+                    return;
+                }
+
+                if constexpr (sizeof...(OperationTs) == 0) {
+                    state.complete(receiver);
+                }
+                else {
+                    (exec::start(operations), ...);
+                }
+            };
+
+        static constexpr auto complete =
+            []<typename IndexT, typename StateT, typename ReceiverT, typename TagT, typename... ArgTs>
+                (IndexT, StateT& state, ReceiverT& receiver, TagT, ArgTs&&... args) noexcept -> void
+            {
+                if constexpr (std::is_same_v<TagT, exec::set_value_t>) {
+                    auto& result = state.values.template get<IndexT::value>();
+                    constexpr bool nothrow = std::is_nothrow_constructible_v<decayed_tuple<ArgTs...>, ArgTs...>;
+
+                    try {
+                        result.emplace(std::forward<ArgTs>(args)...);
+                    }
+                    catch (...) {
+                        if constexpr (!nothrow) {
+                            state.store_error(std::current_exception());
+                        }
+                    }
+                }
+                else if constexpr (std::is_same_v<TagT, exec::set_error_t>) {
+                    state.store_error(std::forward<ArgTs>(args)...);
+                }
+                else {
+                    state.store_stopped();
+                }
+
+                state.arrive(receiver);
+            };
+    };
+
+    template<>
+    struct details::impls_for<when_all_range_t> : default_impls {
+        using when_all_impls = impls_for<when_all_t>;
+
+        template<typename SenderT>
+        using range_of_t = std::remove_cvref_t<data_of_t<SenderT>>;
+
+        template<typename SenderT>
+        using child_sender_t =
+            decltype(std::forward_like<SenderT>(std::declval<std::ranges::range_value_t<range_of_t<SenderT>>&>()));
+
+        template<typename TupleT>
+        struct element {
+            using type = TupleT;
+        };
+
+        template<typename T>
+        struct element<std::tuple<T>> {
+            using type = T;
+        };
+
+        template<typename EnvT, typename ChildT>
+        struct signatures {
+            using child_signatures_t = when_all_impls::signatures<EnvT, ChildT>;
+            using element_t = element<when_all_impls::values_of_t<ChildT, EnvT>>::type;
+
+            using type =
+                meta_merge_t<std::conditional_t<std::is_same_v<element_t, std::tuple<>>,
+                                                completion_signatures<exec::set_value_t()>,
+                                                completion_signatures<exec::set_value_t(std::vector<element_t>)>>,
+                             typename child_signatures_t::errors_t,
+                             completion_signatures<exec::set_stopped_t()>,
+                             std::conditional_t<child_signatures_t::nothrow,
+                                                completion_signatures<>,
+                                                completion_signatures<exec::set_error_t(std::exception_ptr)>>>;
+
+            using errors_t =
+                meta_add_t<std::variant<std::monostate>,
+                           gather_signatures<exec::set_error_t, type, std::type_identity_t, std::variant>>;
+        };
+
+        template<typename EnvT>
+        [[nodiscard]] static constexpr auto allocator_of(const EnvT& env) noexcept {
+            if constexpr (requires { env.query(get_allocator_t{}); }) {
+                return get_allocator(env);
+            }
+            else {
+                return std::allocator<std::byte>{};
+            }
+        }
+
+        // All child operation states live in a single block obtained from the receiver's allocator. Each child writes
+        // its value at its own index of a vector sized up front, straight into the one handed to the receiver when
+        // the value can be default constructed and assigned without throwing. Other values, and bool as writes to a
+        // std::vector<bool> race, go through optionals moved into a vector reserved at connect.
+        template<typename ReceiverT, typename ChildT, typename ElementT, typename ErrorsT>
+        struct state : when_all_impls::shared_state<ReceiverT, ErrorsT> {
+            static constexpr bool direct = std::is_default_constructible_v<ElementT> &&
+                                           std::is_nothrow_move_assignable_v<ElementT> &&
+                                           !std::is_same_v<ElementT, bool>;
+
+            using result_t = std::conditional_t<direct, ElementT, std::optional<ElementT>>;
+
+            struct child_receiver {
+                using receiver_concept = exec::receiver_t;
+
+                state* op;
+                std::size_t index;
+
+                template<typename... Ts>
+                void set_value(Ts&&... values) && noexcept {
+                    op->store_value(index, std::forward<Ts>(values)...);
+                }
+
+                template<typename ErrorT>
+                void set_error(ErrorT&& error) && noexcept {
+                    op->store_error(std::forward<ErrorT>(error));
+                    op->arrive();
+                }
+
+                void set_stopped() && noexcept {
+                    op->store_stopped();
+                    op->arrive();
+                }
+
+                [[nodiscard]] constexpr auto get_env() const noexcept {
+                    return join_env(prop{ get_stop_token, op->stop_source.get_token() },
+                                    forward_env(exec::get_env(*op->outer)));
+                }
+            };
+
+            struct slot {
+                connect_result_t<ChildT, child_receiver> operation;
+
+                slot(ChildT&& child, child_receiver rcvr) :
+                    operation(exec::connect(std::forward<ChildT>(child), std::move(rcvr))) {}
+            };
+
+            using src_alloc_t = decltype(allocator_of(std::declval<env_of_t<ReceiverT>>()));
+            using traits_t = std::allocator_traits<src_alloc_t>::template rebind_traits<slot>;
+
+            ReceiverT* outer;
+            typename traits_t::allocator_type alloc;
+            std::size_t size;
+            slot* slots;
+            std::atomic_size_t count;
+            std::vector<result_t> results{};
+            std::vector<ElementT> unwrapped{};
+
+            template<typename RangeT>
+            explicit state(RangeT&& range, ReceiverT& receiver) :
+                outer(std::addressof(receiver)),
+                alloc(allocator_of(exec::get_env(receiver))),
+                size(std::ranges::size(range)),
+                slots(traits_t::allocate(alloc, size)),
+                count(size)
+            {
+                std::size_t index = 0;
+
+                try {
+                    for (auto&& child : range) {
+                        traits_t::construct(
+                            alloc, slots + index, std::forward_like<RangeT>(child), child_receiver{ this, index });
+                        ++index;
+                    }
+
+                    if constexpr (!std::is_same_v<ElementT, std::tuple<>>) {
+                        results.resize(size);
+
+                        if constexpr (!direct) {
+                            unwrapped.reserve(size);
+                        }
+                    }
+                }
+                catch (...) {
+                    destroy(index);
+                    throw;
+                }
+            }
+
+            state(state&&) = delete;
+
+            ~state() {
+                destroy(size);
+            }
+
+            void destroy(std::size_t constructed) noexcept {
+                for (std::size_t i = 0; i < constructed; ++i) {
+                    traits_t::destroy(alloc, slots + i);
+                }
+
+                traits_t::deallocate(alloc, slots, size);
+            }
+
+            void run() noexcept {
+                if (!this->try_start(*outer)) {
+                    return;
+                }
+
+                if (size == 0) {
+                    complete();
+                    return;
+                }
+
+                // The last child to complete may destroy this state, only locals are used past its start.
+                slot* const first = slots;
+                const std::size_t last = size;
+
+                for (std::size_t i = 0; i < last; ++i) {
+                    exec::start(first[i].operation);
+                }
+            }
+
+            template<typename... Ts>
+            void store_value(std::size_t index, Ts&&... values) noexcept {
+                constexpr bool nothrow = std::is_nothrow_constructible_v<ElementT, Ts...>;
+
+                try {
+                    if constexpr (direct) {
+                        results[index] = ElementT(std::forward<Ts>(values)...);
+                    }
+                    else {
+                        results[index].emplace(std::forward<Ts>(values)...);
+                    }
+                }
+                catch (...) {
+                    if constexpr (!nothrow) {
+                        this->store_error(std::current_exception());
+                    }
+                }
+
+                arrive();
+            }
+
+            void arrive() noexcept {
+                if (count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    complete();
+                }
+            }
+
+            void complete() noexcept {
+                if (this->try_complete_cancelled(*outer)) {
+                    return;
+                }
+
+                if constexpr (std::is_same_v<ElementT, std::tuple<>>) {
+                    exec::set_value(std::move(*outer));
+                }
+                else if constexpr (direct) {
+                    exec::set_value(std::move(*outer), std::move(results));
+                }
+                else {
+                    constexpr bool nothrow = std::is_nothrow_move_constructible_v<ElementT>;
+
+                    try {
+                        for (auto& result : results) {
+                            unwrapped.emplace_back(std::move(*result));
+                        }
+                    }
+                    catch (...) {
+                        if constexpr (!nothrow) {
+                            exec::set_error(std::move(*outer), std::current_exception());
+                            return;
+                        }
+                    }
+
+                    exec::set_value(std::move(*outer), std::move(unwrapped));
+                }
+            }
+        };
+
+        static constexpr auto get_completion_signatures =
+            []<typename SenderT, typename EnvT>(SenderT&&, EnvT&&) noexcept {
+                return typename signatures<std::decay_t<EnvT>, child_sender_t<SenderT>>::type{};
+            };
+
+        static constexpr auto get_state =
+            []<typename SenderT, typename ReceiverT>(SenderT&& sender, ReceiverT& receiver) {
+                using child_t = child_sender_t<SenderT>;
+                using signatures_t = signatures<env_of_t<ReceiverT>, child_t>;
+                using state_t =
+                    state<ReceiverT, child_t, typename signatures_t::element_t, typename signatures_t::errors_t>;
+
+                auto&& data = get_data(std::forward<SenderT>(sender));
+                return state_t{ std::forward_like<SenderT>(data), receiver };
+            };
+
+        static constexpr auto start =
+            []<typename StateT>(StateT& state, auto&) noexcept {
+                state.run();
+            };
+    };
+
+    struct when_all_t {
+        template<sender... SenderTs>
+        [[nodiscard]] constexpr auto operator()(SenderTs&&... senders) const {
+            return details::make_sender(*this, details::product_type{}, std::forward<SenderTs>(senders)...);
+        }
+    };
+    inline constexpr when_all_t when_all{};
+
+    struct when_all_range_t {
+        template<std::ranges::forward_range RangeT>
+        requires std::ranges::sized_range<RangeT> && sender<std::ranges::range_value_t<RangeT>>
+        [[nodiscard]] constexpr auto operator()(RangeT&& range) const {
+            return details::make_sender(*this, std::forward<RangeT>(range));
+        }
+    };
+    inline constexpr when_all_range_t when_all_range{};
+}
+
+#endif // !EXEC_WHEN_ALL_HPP
\ No newline at end of file
@@ -0,0 +1,196 @@
+#ifndef EXEC_WHEN_ANY_HPP
+#define EXEC_WHEN_ANY_HPP
+
+#include "exec/completions.hpp"
+#include "exec/completion_signatures.hpp"
+#include "exec/env.hpp"
+#include "exec/operation_state.hpp"
+#include "exec/receiver.hpp"
+#include "exec/sender.hpp"
+#include "exec/stop_token.hpp"
+
+#include "exec/details/basic_sender.hpp"
+#include "exec/details/decayed_tuple.hpp"
+#include "exec/details/forward_env.hpp"
+#include "exec/details/join_env.hpp"
+#include "exec/details/meta_add.hpp"
+#include "exec/details/meta_bind.hpp"
+#include "exec/details/meta_merge.hpp"
+#include "exec/details/product_type.hpp"
+#include "exec/details/signature_info.hpp"
+#include "exec/details/type_list.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace exec {
+    struct when_any_t;
+
+    template<>
+    struct details::impls_for<when_any_t> : default_impls {
+        template<typename SigT>
+        using as_tuple_t =
+            signature_args_of<completion_signatures<SigT>>::template apply<
+                meta_bind_front<decayed_tuple,
+                                completion_tag_of_t<completion_signatures<SigT>>>::template type>;
+
+        template<typename... SigTs>
+        using as_variant_t = std::variant<std::monostate, as_tuple_t<SigTs>...>;
+
+        template<typename TagT, typename... ArgTs>
+        using decayed_signature_t = completion_signatures<TagT(std::decay_t<ArgTs>...)>;
+
+        template<typename SigT>
+        using as_decayed_t =
+            signature_args_of<completion_signatures<SigT>>::template apply<
+                meta_bind_front<decayed_signature_t,
+                                completion_tag_of_t<completion_signatures<SigT>>>::template type>;
+
+        template<typename... SigTs>
+        using decayed_signatures_t = meta_add_t<completion_signatures<>, as_decayed_t<SigTs>...>;
+
+        template<typename... ArgTs>
+        struct nothrow_movable {
+            static constexpr bool value = (std::is_nothrow_constructible_v<std::decay_t<ArgTs>, ArgTs> && ... && true);
+        };
+
+        template<typename... SigTs>
+        struct nothrow_signatures {
+            static constexpr bool value =
+                (signature_args_of<completion_signatures<SigTs>>::template apply<nothrow_movable>::value && ... && true);
+        };
+
+        template<typename EnvT, typename... ChildTs>
+        struct signatures {
+            using children_t = meta_merge_t<completion_signatures<>, completion_signatures_of_t<ChildTs, EnvT>...>;
+
+            static constexpr bool nothrow = elements_of<children_t>::template apply<nothrow_signatures>::value;
+
+            using type =
+                meta_merge_t<typename elements_of<children_t>::template apply<decayed_signatures_t>,
+                             completion_signatures<exec::set_stopped_t()>,
+                             std::conditional_t<nothrow,
+                                                completion_signatures<>,
+                                                completion_signatures<exec::set_error_t(std::exception_ptr)>>>;
+        };
+
+        // The first child to complete wins a single compare-exchange, stores its result and stops its siblings. The
+        // result is delivered once every child has completed.
+        template<typename ReceiverT, typename ResultT, std::size_t COUNT>
+        struct state {
+            struct on_stop {
+                inplace_stop_source& source;
+
+                void operator()() const noexcept {
+                    source.request_stop();
+                }
+            };
+
+            using stop_token_t = stop_token_of_t<env_of_t<ReceiverT>>;
+            using stop_callback_t = typename stop_token_t::template callback_type<on_stop>;
+
+            std::atomic_size_t count{ COUNT };
+            std::atomic_bool won{ false };
+            inplace_stop_source stop_source{};
+            std::optional<stop_callback_t> stop_callback{};
+            ResultT result{};
+
+            template<typename TagT, typename... ArgTs>
+            void arrive(ReceiverT& receiver, TagT, ArgTs&&... args) noexcept {
+                if (!won.exchange(true, std::memory_order_relaxed)) {
+                    using result_t = decayed_tuple<TagT, ArgTs...>;
+                    constexpr bool nothrow = std::is_nothrow_constructible_v<result_t, TagT, ArgTs...>;
+
+                    try {
+                        result.template emplace<result_t>(TagT{}, std::forward<ArgTs>(args)...);
+                    }
+                    catch (...) {
+                        if constexpr (!nothrow) {
+                            result.template emplace<std::tuple<exec::set_error_t, std::exception_ptr>>(
+                                exec::set_error_t{}, std::current_exception());
+                        }
+                    }
+
+                    stop_source.request_stop();
+                }
+
+                if (count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    complete(receiver);
+                }
+            }
+
+            void complete(ReceiverT& receiver) noexcept {
+                stop_callback.reset();
+
+                std::visit([&]<typename TupleT>(TupleT& tuple) noexcept {
+                    if constexpr (!std::is_same_v<TupleT, std::monostate>) {
+                        std::apply([&]<typename TagT, typename... Ts>(TagT tag, Ts&... values) noexcept {
+                            tag(std::move(receiver), std::move(values)...);
+                        }, tuple);
+                    }
+                }, result);
+            }
+        };
+
+        static constexpr auto get_completion_signatures =
+            []<typename SenderT, typename EnvT>(SenderT&& sender, EnvT&&) noexcept {
+                return std::forward<SenderT>(sender).apply([]<typename... ChildTs>(auto&&, auto&&, ChildTs&&...) noexcept {
+                    return typename signatures<std::decay_t<EnvT>, ChildTs...>::type{};
+                });
+            };
+
+        static constexpr auto get_env =
+            []<typename ReceiverT>(auto, auto& state, const ReceiverT& receiver) noexcept {
+                return join_env(prop{ get_stop_token, state.stop_source.get_token() },
+                                forward_env(exec::get_env(receiver)));
+            };
+
+        static constexpr auto get_state =
+            []<typename SenderT, typename ReceiverT>(SenderT&& sender, ReceiverT&) noexcept {
+                return std::forward<SenderT>(sender).apply([]<typename... ChildTs>(auto&&, auto&&, ChildTs&&...) noexcept {
+                    using signatures_t = signatures<env_of_t<ReceiverT>, ChildTs...>;
+                    using result_t = elements_of<typename signatures_t::type>::template apply<as_variant_t>;
+
+                    return state<ReceiverT, result_t, sizeof...(ChildTs)>{};
+                });
+            };
+
+        static constexpr auto start =
+            []<typename StateT, typename ReceiverT, typename... OperationTs>
+                (StateT& state, ReceiverT& receiver, OperationTs&... operations) noexcept
+            {
+                auto token = get_stop_token(exec::get_env(receiver));
+                if (token.stop_requested()) {
+                    exec::set_stopped(std::move(receiver));
+                    return;
+                }
+
+                state.stop_callback.emplace(token, typename StateT::on_stop{ state.stop_source });
+                (exec::start(operations), ...);
+            };
+
+        static constexpr auto complete =
+            []<typename StateT, typename ReceiverT, typename TagT, typename... ArgTs>
+                (auto, StateT& state, ReceiverT& receiver, TagT tag, ArgTs&&... args) noexcept -> void
+            {
+                state.arrive(receiver, tag, std::forward<ArgTs>(args)...);
+            };
+    };
+
+    struct when_any_t {
+        template<sender SenderT, sender... SenderTs>
+        [[nodiscard]] constexpr auto operator()(SenderT&& first, SenderTs&&... senders) const {
+            return details::make_sender(
+                *this, details::product_type{}, std::forward<SenderT>(first), std::forward<SenderTs>(senders)...);
+        }
+    };
+    inline constexpr when_any_t when_any{};
+}
+
+#endif // !EXEC_WHEN_ANY_HPP
\ No newline at end of file
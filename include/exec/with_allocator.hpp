@@ -0,0 +1,47 @@
+#ifndef EXEC_WITH_ALLOCATOR_HPP
+#define EXEC_WITH_ALLOCATOR_HPP
+
+#include "exec/allocator.hpp"
+#include "exec/env.hpp"
+#include "exec/monotonic_arena.hpp"
+#include "exec/sender.hpp"
+#include "exec/sender_adapter_closure.hpp"
+
+#include "exec/details/basic_closure.hpp"
+#include "exec/details/product_type.hpp"
+#include "exec/details/write_env.hpp"
+
+#include <cstddef>
+#include <utility>
+
+namespace exec {
+    // Makes `alloc` the answer to get_allocator for every operation of the wrapped sender. Given a monotonic_arena,
+    // everything the pipeline allocates through its env comes from the arena, which the caller releases in one shot
+    // once the pipeline has completed and its operation state is gone.
+    struct with_allocator_t {
+        template<sender SenderT, allocator AllocT>
+        [[nodiscard]] constexpr auto operator()(SenderT&& sender, AllocT alloc) const noexcept {
+            return details::write_env(std::forward<SenderT>(sender), prop{ get_allocator, std::move(alloc) });
+        }
+
+        template<sender SenderT>
+        [[nodiscard]] constexpr auto operator()(SenderT&& sender, monotonic_arena& arena) const noexcept {
+            return (*this)(std::forward<SenderT>(sender), monotonic_allocator<std::byte>{ arena });
+        }
+
+        template<allocator AllocT>
+        [[nodiscard]] constexpr auto operator()(AllocT alloc) const {
+            return details::basic_closure{
+                sender_adapter_closure<with_allocator_t>{},
+                details::product_type{ std::move(alloc) }
+            };
+        }
+
+        [[nodiscard]] constexpr auto operator()(monotonic_arena& arena) const {
+            return (*this)(monotonic_allocator<std::byte>{ arena });
+        }
+    };
+    inline constexpr with_allocator_t with_allocator{};
+}
+
+#endif // !EXEC_WITH_ALLOCATOR_HPP
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef EXEC_WITH_TRACER_HPP
+#define EXEC_WITH_TRACER_HPP
+
+#include "exec/env.hpp"
+#include "exec/sender.hpp"
+#include "exec/sender_adapter_closure.hpp"
+#include "exec/trace_recorder.hpp"
+#include "exec/tracer.hpp"
+
+#include "exec/details/basic_closure.hpp"
+#include "exec/details/product_type.hpp"
+#include "exec/details/write_env.hpp"
+
+#include <utility>
+
+namespace exec {
+    // Makes `tracer` the answer to get_tracer for every operation of the wrapped sender, each of them then reports its
+    // start and the completions of its children. Senders outside of with_tracer are not traced and pay nothing.
+    struct with_tracer_t {
+        template<sender SenderT, tracer TracerT>
+        [[nodiscard]] constexpr auto operator()(SenderT&& sender, TracerT tracer) const noexcept {
+            return details::write_env(std::forward<SenderT>(sender), prop{ get_tracer, std::move(tracer) });
+        }
+
+        template<sender SenderT>
+        [[nodiscard]] constexpr auto operator()(SenderT&& sender, trace_recorder& recorder) const noexcept {
+            return (*this)(std::forward<SenderT>(sender), recorder.get_tracer());
+        }
+
+        template<tracer TracerT>
+        [[nodiscard]] constexpr auto operator()(TracerT tracer) const {
+            return details::basic_closure{
+                sender_adapter_closure<with_tracer_t>{},
+                details::product_type{ std::move(tracer) }
+            };
+        }
+
+        [[nodiscard]] constexpr auto operator()(trace_recorder& recorder) const {
+            return (*this)(recorder.get_tracer());
+        }
+    };
+    inline constexpr with_tracer_t with_tracer{};
+}
+
+#endif // !EXEC_WITH_TRACER_HPP
\ No newline at end of file